@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace aut {
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of a value.
+ * @param value Value which is treated as if it was read by unknown code.
+ */
+template<typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+    (void)*p;
+#endif
+}
+
+/**
+ * @brief Prevents the compiler from reordering or eliminating memory accesses across this point.
+ */
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * @brief Options of a micro-benchmark run.
+ */
+struct benchmark_options {
+    /**
+     * @brief Number of measured samples. Each sample executes the function a calibrated number of times.
+     */
+    size_t samples = 100;
+
+    /**
+     * @brief Number of samples which are executed, but not measured, before the measurement starts.
+     */
+    size_t warmup_samples = 10;
+
+    /**
+     * @brief The number of iterations per sample is doubled until a sample takes at least this long.
+     *        0 disables the calibration and runs one iteration per sample.
+     */
+    std::chrono::nanoseconds min_sample_time = std::chrono::microseconds{ 200 };
+
+    /**
+     * @brief Evict the data caches before each sample by writing a buffer of cache_flush_size bytes.
+     */
+    bool flush_cache = false;
+    size_t cache_flush_size = 32 * 1024 * 1024;
+};
+
+/**
+ * @brief Statistics of a micro-benchmark run. All times are per iteration, in nanoseconds.
+ */
+struct benchmark_result {
+    std::string name;
+    size_t samples = 0;
+    size_t iterations_per_sample = 0;
+
+    double mean = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+
+    /**
+     * @brief 95% confidence interval of the mean.
+     */
+    double ci95_low = 0.0;
+    double ci95_high = 0.0;
+};
+
+namespace detail {
+
+/**
+ * @brief Percentile of sorted values with linear interpolation between the closest ranks.
+ */
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const double rank = p * static_cast<double>(sorted.size() - 1);
+    const size_t lower = static_cast<size_t>(rank);
+    const size_t upper = std::min(lower + 1, sorted.size() - 1);
+    const double frac = rank - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * frac;
+}
+
+/**
+ * @brief Two-sided 95% quantile of the Student t-distribution.
+ * @param dof Degrees of freedom.
+ */
+inline double t_quantile_95(size_t dof) {
+    constexpr double table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    if (dof == 0) return 0.0;
+    if (dof <= std::size(table)) return table[dof - 1];
+    return 1.960;
+}
+
+inline void flush_cache(size_t size) {
+    static std::vector<char> buffer;
+    buffer.resize(size);
+    for (size_t i = 0; i < buffer.size(); i += 64) buffer[i]++;
+    do_not_optimize(buffer.data());
+    clobber_memory();
+}
+
+template<typename Func>
+inline void run_iterations(Func& func, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        if constexpr (std::is_void_v<std::invoke_result_t<Func&>>) {
+            func();
+            clobber_memory();
+        }
+        else {
+            do_not_optimize(func());
+        }
+    }
+}
+
+template<typename Func>
+inline double time_iterations(Func& func, size_t iterations) {
+    const auto t1 = std::chrono::steady_clock::now();
+    run_iterations(func, iterations);
+    const auto t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t2 - t1).count();
+}
+
+}
+
+/**
+ * @brief Computes the statistics of per-iteration sample times.
+ * @param name Name of the benchmark.
+ * @param times Per-iteration time of each sample in nanoseconds.
+ * @param iterations_per_sample Number of iterations of each sample.
+ */
+inline benchmark_result summarize(std::string name, std::vector<double> times, size_t iterations_per_sample) {
+    benchmark_result r;
+    r.name = std::move(name);
+    r.samples = times.size();
+    r.iterations_per_sample = iterations_per_sample;
+    if (times.empty()) return r;
+
+    std::sort(times.begin(), times.end());
+    const double n = static_cast<double>(times.size());
+    r.mean = std::accumulate(times.begin(), times.end(), 0.0) / n;
+
+    double sq = 0.0;
+    for (const auto t : times) sq += (t - r.mean) * (t - r.mean);
+    r.stddev = times.size() > 1 ? std::sqrt(sq / (n - 1)) : 0.0;
+
+    r.min = times.front();
+    r.max = times.back();
+    r.p50 = detail::percentile(times, 0.50);
+    r.p90 = detail::percentile(times, 0.90);
+    r.p99 = detail::percentile(times, 0.99);
+
+    const double half_width = detail::t_quantile_95(times.size() - 1) * r.stddev / std::sqrt(n);
+    r.ci95_low = r.mean - half_width;
+    r.ci95_high = r.mean + half_width;
+    return r;
+}
+
+/**
+ * @brief Measures the runtime of a function.
+ *
+ * The number of iterations per sample is calibrated, so that clock resolution and overhead are negligible.
+ * After a warm-up, each sample is timed with std::chrono::steady_clock. Return values are passed to
+ * do_not_optimize(), so the calls can not be removed by the compiler.
+ *
+ * @param name Name of the benchmark, used in the printed and JSON output.
+ * @param func Function without arguments.
+ * @param options Benchmark options.
+ * @return Returns the statistics of the per-iteration time.
+ */
+template<typename Func>
+benchmark_result run_benchmark(std::string name, Func&& func, const benchmark_options& options = {}) {
+    size_t iterations = 1;
+    if (options.min_sample_time.count() > 0) {
+        const double target = static_cast<double>(options.min_sample_time.count());
+        while (detail::time_iterations(func, iterations) < target && iterations < (size_t{ 1 } << 40)) {
+            iterations *= 2;
+        }
+    }
+
+    for (size_t i = 0; i < options.warmup_samples; i++) {
+        detail::run_iterations(func, iterations);
+    }
+
+    std::vector<double> times;
+    times.reserve(options.samples);
+    for (size_t i = 0; i < options.samples; i++) {
+        if (options.flush_cache) detail::flush_cache(options.cache_flush_size);
+        times.push_back(detail::time_iterations(func, iterations) / static_cast<double>(iterations));
+    }
+
+    return summarize(std::move(name), std::move(times), iterations);
+}
+
+/**
+ * @brief Overloaded left shift operator for printing a human readable benchmark summary.
+ */
+inline std::ostream& operator<<(std::ostream& os, const benchmark_result& r)
+{
+    os << r.name << ": " << r.samples << " samples x " << r.iterations_per_sample << " iterations\n"
+       << "  mean " << r.mean << " ns (95% CI [" << r.ci95_low << ", " << r.ci95_high << "]), stddev " << r.stddev << " ns\n"
+       << "  min " << r.min << " ns, p50 " << r.p50 << " ns, p90 " << r.p90 << " ns, p99 " << r.p99 << " ns, max " << r.max << " ns\n";
+    return os;
+}
+
+/**
+ * @brief Writes a benchmark result as a single JSON object.
+ */
+inline void write_json(std::ostream& os, const benchmark_result& r) {
+    os << "{\"name\": \"";
+    for (const char c : r.name) {
+        if (c == '"' || c == '\\') os << '\\';
+        os << c;
+    }
+    os << "\", \"samples\": " << r.samples << ", \"iterations_per_sample\": " << r.iterations_per_sample
+       << ", \"unit\": \"ns\", \"mean\": " << r.mean << ", \"stddev\": " << r.stddev
+       << ", \"min\": " << r.min << ", \"max\": " << r.max
+       << ", \"p50\": " << r.p50 << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99
+       << ", \"ci95_low\": " << r.ci95_low << ", \"ci95_high\": " << r.ci95_high << "}";
+}
+
+/**
+ * @brief Writes a list of benchmark results as a JSON document: {"benchmarks": [...]}.
+ */
+inline void write_json(std::ostream& os, const std::vector<benchmark_result>& results) {
+    os << "{\"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        os << (i > 0 ? ",\n  " : "\n  ");
+        write_json(os, results[i]);
+    }
+    os << "\n]}\n";
+}
+
+}
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "interval_set.hpp"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define AUT_BULK_AVX512 1
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define AUT_BULK_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUT_BULK_SSE2 1
+#endif
+
+namespace aut {
+
+namespace detail {
+
+/**
+ * @brief Vector operations for the bulk validation kernels.
+ *
+ * One specialization per instruction set and element type. The instruction set is selected at compile time from the
+ * target flags (e.g. -mavx2 or -mavx512f), the widest available one is used. ge() and le() are never called with
+ * the ends of the domain, since these bounds are left out of the interval checks.
+ *
+ * @tparam T Element type, int32_t or float.
+ */
+template<typename T>
+struct simd_ops;
+
+#if defined(AUT_BULK_AVX512)
+
+template<>
+struct simd_ops<int32_t> {
+    using vec = __m512i;
+    using mask = __mmask16;
+    static constexpr size_t width = 16;
+
+    static vec load(const int32_t* p) { return _mm512_loadu_si512(p); }
+    static mask all() { return 0xffff; }
+    static mask none() { return 0; }
+    static mask ge(vec v, int32_t c) { return _mm512_cmp_epi32_mask(v, _mm512_set1_epi32(c), _MM_CMPINT_GE); }
+    static mask le(vec v, int32_t c) { return _mm512_cmp_epi32_mask(v, _mm512_set1_epi32(c), _MM_CMPINT_LE); }
+    static mask eq(vec v, int32_t c) { return _mm512_cmp_epi32_mask(v, _mm512_set1_epi32(c), _MM_CMPINT_EQ); }
+    static mask ordered(vec) { return all(); }
+    static mask unordered(vec) { return none(); }
+    static mask and_(mask a, mask b) { return a & b; }
+    static mask or_(mask a, mask b) { return a | b; }
+    static uint32_t bits(mask m) { return m; }
+};
+
+template<>
+struct simd_ops<float> {
+    using vec = __m512;
+    using mask = __mmask16;
+    static constexpr size_t width = 16;
+
+    static vec load(const float* p) { return _mm512_loadu_ps(p); }
+    static mask all() { return 0xffff; }
+    static mask none() { return 0; }
+    static mask ge(vec v, float c) { return _mm512_cmp_ps_mask(v, _mm512_set1_ps(c), _CMP_GE_OQ); }
+    static mask le(vec v, float c) { return _mm512_cmp_ps_mask(v, _mm512_set1_ps(c), _CMP_LE_OQ); }
+    static mask eq(vec v, float c) { return _mm512_cmp_ps_mask(v, _mm512_set1_ps(c), _CMP_EQ_OQ); }
+    static mask ordered(vec v) { return _mm512_cmp_ps_mask(v, v, _CMP_ORD_Q); }
+    static mask unordered(vec v) { return _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q); }
+    static mask and_(mask a, mask b) { return a & b; }
+    static mask or_(mask a, mask b) { return a | b; }
+    static uint32_t bits(mask m) { return m; }
+};
+
+#elif defined(AUT_BULK_AVX2)
+
+template<>
+struct simd_ops<int32_t> {
+    using vec = __m256i;
+    using mask = __m256i;
+    static constexpr size_t width = 8;
+
+    static vec load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static mask all() { return _mm256_set1_epi32(-1); }
+    static mask none() { return _mm256_setzero_si256(); }
+    // There is no signed >= or <=: v >= c is v > c - 1 and v <= c is c + 1 > v.
+    static mask ge(vec v, int32_t c) { return _mm256_cmpgt_epi32(v, _mm256_set1_epi32(c - 1)); }
+    static mask le(vec v, int32_t c) { return _mm256_cmpgt_epi32(_mm256_set1_epi32(c + 1), v); }
+    static mask eq(vec v, int32_t c) { return _mm256_cmpeq_epi32(v, _mm256_set1_epi32(c)); }
+    static mask ordered(vec) { return all(); }
+    static mask unordered(vec) { return none(); }
+    static mask and_(mask a, mask b) { return _mm256_and_si256(a, b); }
+    static mask or_(mask a, mask b) { return _mm256_or_si256(a, b); }
+    static uint32_t bits(mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m))); }
+};
+
+template<>
+struct simd_ops<float> {
+    using vec = __m256;
+    using mask = __m256;
+    static constexpr size_t width = 8;
+
+    static vec load(const float* p) { return _mm256_loadu_ps(p); }
+    static mask all() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static mask none() { return _mm256_setzero_ps(); }
+    static mask ge(vec v, float c) { return _mm256_cmp_ps(v, _mm256_set1_ps(c), _CMP_GE_OQ); }
+    static mask le(vec v, float c) { return _mm256_cmp_ps(v, _mm256_set1_ps(c), _CMP_LE_OQ); }
+    static mask eq(vec v, float c) { return _mm256_cmp_ps(v, _mm256_set1_ps(c), _CMP_EQ_OQ); }
+    static mask ordered(vec v) { return _mm256_cmp_ps(v, v, _CMP_ORD_Q); }
+    static mask unordered(vec v) { return _mm256_cmp_ps(v, v, _CMP_UNORD_Q); }
+    static mask and_(mask a, mask b) { return _mm256_and_ps(a, b); }
+    static mask or_(mask a, mask b) { return _mm256_or_ps(a, b); }
+    static uint32_t bits(mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+};
+
+#elif defined(AUT_BULK_SSE2)
+
+template<>
+struct simd_ops<int32_t> {
+    using vec = __m128i;
+    using mask = __m128i;
+    static constexpr size_t width = 4;
+
+    static vec load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static mask all() { return _mm_set1_epi32(-1); }
+    static mask none() { return _mm_setzero_si128(); }
+    // There is no signed >= or <=: v >= c is v > c - 1 and v <= c is c + 1 > v.
+    static mask ge(vec v, int32_t c) { return _mm_cmpgt_epi32(v, _mm_set1_epi32(c - 1)); }
+    static mask le(vec v, int32_t c) { return _mm_cmpgt_epi32(_mm_set1_epi32(c + 1), v); }
+    static mask eq(vec v, int32_t c) { return _mm_cmpeq_epi32(v, _mm_set1_epi32(c)); }
+    static mask ordered(vec) { return all(); }
+    static mask unordered(vec) { return none(); }
+    static mask and_(mask a, mask b) { return _mm_and_si128(a, b); }
+    static mask or_(mask a, mask b) { return _mm_or_si128(a, b); }
+    static uint32_t bits(mask m) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(m))); }
+};
+
+template<>
+struct simd_ops<float> {
+    using vec = __m128;
+    using mask = __m128;
+    static constexpr size_t width = 4;
+
+    static vec load(const float* p) { return _mm_loadu_ps(p); }
+    static mask all() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static mask none() { return _mm_setzero_ps(); }
+    static mask ge(vec v, float c) { return _mm_cmpge_ps(v, _mm_set1_ps(c)); }
+    static mask le(vec v, float c) { return _mm_cmple_ps(v, _mm_set1_ps(c)); }
+    static mask eq(vec v, float c) { return _mm_cmpeq_ps(v, _mm_set1_ps(c)); }
+    static mask ordered(vec v) { return _mm_cmpord_ps(v, v); }
+    static mask unordered(vec v) { return _mm_cmpunord_ps(v, v); }
+    static mask and_(mask a, mask b) { return _mm_and_ps(a, b); }
+    static mask or_(mask a, mask b) { return _mm_or_ps(a, b); }
+    static uint32_t bits(mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+};
+
+#endif
+
+/**
+ * @brief Element type, which is stored in a span of constraints of type C.
+ */
+template<typename C>
+using element_type = typename std::remove_cvref_t<C>::value_type;
+
+/**
+ * @brief Constraints, whose spans are validated with the vector kernels: int32_t or float elements and an interval
+ *        form with at most max_fold_size intervals. All other constraints are validated element by element.
+ */
+template<typename C>
+concept simd_validatable = requires { simd_ops<element_type<C>>::width; } && has_intervals<C> &&
+    intervals_of<std::remove_cvref_t<C>>::value.size <= interval_check<std::remove_cvref_t<C>>::max_fold_size &&
+    std::is_standard_layout_v<C> && sizeof(C) == sizeof(element_type<C>);
+
+/**
+ * @brief Vector kernels over the interval form of a constraint.
+ */
+template<typename C>
+struct bulk_kernel {
+    using T = element_type<C>;
+    using ops = simd_ops<T>;
+    using vec = typename ops::vec;
+    using mask = typename ops::mask;
+    static constexpr const auto& set = intervals_of<std::remove_cvref_t<C>>::value;
+    static constexpr size_t width = ops::width;
+
+    /**
+     * @brief Bit i is set if lane i is invalid.
+     */
+    static uint32_t invalid_bits(vec v) {
+        return ~ops::bits(valid(v, std::make_index_sequence<set.size>{})) & ((uint32_t{ 1 } << width) - 1);
+    }
+
+    static size_t count_invalid(const T* values, size_t n) {
+        // The lane bits of several vectors are packed into one word, so there is one popcount per 32 elements.
+        constexpr size_t group = 32 / width;
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + group * width <= n; i += group * width) {
+            uint32_t bits = 0;
+            for (size_t g = 0; g < group; g++) bits |= invalid_bits(ops::load(values + i + g * width)) << (g * width);
+            count += std::popcount(bits);
+        }
+        for (; i + width <= n; i += width) count += std::popcount(invalid_bits(ops::load(values + i)));
+        for (; i < n; i++) count += !interval_check<std::remove_cvref_t<C>>::contains(values[i]);
+        return count;
+    }
+
+    static size_t first_invalid(const T* values, size_t n) {
+        size_t i = 0;
+        // Four vectors per iteration keep the loads in flight and only need one branch.
+        for (; i + 4 * width <= n; i += 4 * width) {
+            const uint32_t b0 = invalid_bits(ops::load(values + i));
+            const uint32_t b1 = invalid_bits(ops::load(values + i + width));
+            const uint32_t b2 = invalid_bits(ops::load(values + i + 2 * width));
+            const uint32_t b3 = invalid_bits(ops::load(values + i + 3 * width));
+            if ((b0 | b1 | b2 | b3) != 0) break;
+        }
+        for (; i + width <= n; i += width) {
+            const uint32_t b = invalid_bits(ops::load(values + i));
+            if (b != 0) return i + std::countr_zero(b);
+        }
+        for (; i < n; i++) {
+            if (!interval_check<std::remove_cvref_t<C>>::contains(values[i])) return i;
+        }
+        return n;
+    }
+
+private:
+    template<size_t... Is>
+    static mask valid(vec v, std::index_sequence<Is...>) {
+        mask m = set.nan ? ops::unordered(v) : ops::none();
+        ((m = ops::or_(m, in<Is>(v))), ...);
+        return m;
+    }
+
+    template<size_t I>
+    static mask in(vec v) {
+        constexpr interval<T> iv = set.intervals[I];
+        constexpr bool open_below = iv.lo == domain_min<T>();
+        constexpr bool open_above = iv.hi == domain_max<T>();
+        if constexpr (open_below && open_above) return ops::ordered(v);
+        else if constexpr (open_below) return ops::le(v, iv.hi);
+        else if constexpr (open_above) return ops::ge(v, iv.lo);
+        else if constexpr (iv.lo == iv.hi) return ops::eq(v, iv.lo);
+        else return ops::and_(ops::ge(v, iv.lo), ops::le(v, iv.hi));
+    }
+};
+
+/**
+ * @brief Element values of a span of constraints. Constraints are standard-layout wrappers of a single value,
+ *        so the span can be read as an array of these values.
+ */
+template<typename C>
+const element_type<C>* element_data(std::span<const C> values) {
+    return reinterpret_cast<const element_type<C>*>(values.data());
+}
+
+}
+
+/**
+ * @brief Returns the number of invalid constraints in a span.
+ */
+template<typename C>
+size_t count_invalid(std::span<const C> values) {
+    if constexpr (detail::simd_validatable<C>) {
+        return detail::bulk_kernel<C>::count_invalid(detail::element_data(values), values.size());
+    }
+    else {
+        size_t count = 0;
+        for (const auto& v : values) count += !v.is_valid();
+        return count;
+    }
+}
+
+/**
+ * @brief Returns the index of the first invalid constraint in a span, or the size of the span if all are valid.
+ */
+template<typename C>
+size_t first_invalid(std::span<const C> values) {
+    if constexpr (detail::simd_validatable<C>) {
+        return detail::bulk_kernel<C>::first_invalid(detail::element_data(values), values.size());
+    }
+    else {
+        for (size_t i = 0; i < values.size(); i++) {
+            if (!values[i].is_valid()) return i;
+        }
+        return values.size();
+    }
+}
+
+/**
+ * @brief Returns true if all constraints in a span are valid. Stops at the first invalid one.
+ */
+template<typename C>
+bool all_valid(std::span<const C> values) {
+    return first_invalid(values) == values.size();
+}
+
+/**
+ * @brief Overloads for contiguous ranges, e.g. std::vector<in_range<0, 100>> or std::array.
+ */
+template<std::ranges::contiguous_range R> requires is_constrained<std::ranges::range_value_t<R>>
+size_t count_invalid(const R& values) {
+    return count_invalid(std::span<const std::ranges::range_value_t<R>>{ values });
+}
+
+template<std::ranges::contiguous_range R> requires is_constrained<std::ranges::range_value_t<R>>
+size_t first_invalid(const R& values) {
+    return first_invalid(std::span<const std::ranges::range_value_t<R>>{ values });
+}
+
+template<std::ranges::contiguous_range R> requires is_constrained<std::ranges::range_value_t<R>>
+bool all_valid(const R& values) {
+    return all_valid(std::span<const std::ranges::range_value_t<R>>{ values });
+}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "evaluation.hpp"
+
+namespace aut {
+
+/**
+ * @brief Flat index space over the cartesian product of the border values of all arguments.
+ *
+ * A case index is decomposed in a mixed radix system, where the radix of each digit is the number of
+ * border values of the corresponding argument. The last argument changes fastest.
+ * Each case can be computed independently from its index, without iterating over the previous ones.
+ *
+ * @tparam Args Constrained argument types of the function under test.
+ */
+template<typename... Args>
+struct case_space {
+    /**
+     * @brief Tuple with one value per argument, which can be passed to the function under test with std::apply.
+     */
+    using value_tuple = std::tuple<typename evaluate<std::remove_cvref_t<Args>>::value_type...>;
+
+    /**
+     * @brief Number of arguments.
+     */
+    static constexpr size_t arity = sizeof...(Args);
+
+    /**
+     * @brief Number of candidate values per argument.
+     */
+    static constexpr std::array<size_t, arity> radices{ std::size(evaluate<std::remove_cvref_t<Args>>::valid_border_values)... };
+
+    /**
+     * @brief Number of test cases.
+     */
+    static constexpr size_t size = (size_t{ 1 } * ... * std::size(evaluate<std::remove_cvref_t<Args>>::valid_border_values));
+
+    /**
+     * @brief Decomposes a case index into the index of the candidate value of each argument.
+     * @param index Index of the test case.
+     * @return Returns one candidate index per argument.
+     */
+    static constexpr std::array<size_t, arity> digits(size_t index) {
+        std::array<size_t, arity> d{};
+        for (size_t i = arity; i-- > 0;) {
+            d[i] = index % radices[i];
+            index /= radices[i];
+        }
+        return d;
+    }
+
+    /**
+     * @brief Returns the argument values of a single test case.
+     * @param index Index of the test case in [0, size).
+     * @return Returns a tuple with one value per argument.
+     */
+    static constexpr value_tuple at(size_t index) {
+        return at_impl(digits(index), std::index_sequence_for<Args...>{});
+    }
+
+    /**
+     * @brief Same as at().
+     */
+    constexpr value_tuple operator[](size_t index) const {
+        return at(index);
+    }
+
+private:
+    template<size_t... Is>
+    static constexpr value_tuple at_impl(const std::array<size_t, arity>& d, std::index_sequence<Is...>) {
+        return value_tuple{ evaluate<std::remove_cvref_t<Args>>::valid_border_values[d[Is]]... };
+    }
+};
+
+namespace detail {
+
+template<typename T>
+struct case_space_of;
+
+template<template<typename...> typename C, typename... Args>
+struct case_space_of<C<Args...>> {
+    using type = case_space<Args...>;
+};
+
+}
+
+/**
+ * @brief Case space of a tuple-like list of argument types, e.g. std::tuple<Args...>.
+ */
+template<typename ArgList>
+using case_space_of = typename detail::case_space_of<ArgList>::type;
+
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace aut {
+
+/**
+ * @brief When the constraints check their own value.
+ */
+enum class check_mode {
+    /**
+     * @brief Never. Constrained types compile to the same code as their raw value types.
+     */
+    none,
+    /**
+     * @brief When a constraint is constructed from a raw value, i.e. when an argument is passed to or a result is
+     *        returned from a function with constrained types, and on assignments of raw values. In-place modifications
+     *        with +=, ++ etc. are not checked.
+     */
+    boundary,
+    /**
+     * @brief Like boundary, and additionally after every in-place modification.
+     */
+    always
+};
+
+/**
+ * @brief What happens if a check fails.
+ */
+enum class violation_action {
+    /**
+     * @brief Prints the violation to std::cerr and calls std::abort().
+     */
+    abort,
+    /**
+     * @brief Throws a constraint_violation.
+     */
+    throw_exception,
+    /**
+     * @brief Prints the violation to std::clog and continues with the invalid value.
+     */
+    log
+};
+
+/**
+ * @brief Checking policy of a constraint.
+ * @tparam Mode When the value is checked.
+ * @tparam Action What happens if the check fails.
+ */
+template<check_mode Mode, violation_action Action = violation_action::abort>
+struct check_policy {
+    static constexpr check_mode mode = Mode;
+    static constexpr violation_action action = Action;
+};
+
+// The build-wide policy. Both macros have to be the same in all translation units of a program, e.g. by setting the
+// AUT_CHECK_MODE and AUT_VIOLATION_ACTION CMake options.
+#ifndef AUT_CHECK_MODE
+#define AUT_CHECK_MODE none
+#endif
+
+#ifndef AUT_VIOLATION_ACTION
+#define AUT_VIOLATION_ACTION abort
+#endif
+
+using default_check_policy = check_policy<check_mode::AUT_CHECK_MODE, violation_action::AUT_VIOLATION_ACTION>;
+
+/**
+ * @brief Checking policy of a constraint type. Specialize it to override the build-wide policy for single types, e.g.
+ *        to always check the inputs of a safety-critical function.
+ * @tparam C Constraint type.
+ */
+template<typename C>
+struct check_policy_of {
+    using type = default_check_policy;
+};
+
+/**
+ * @brief Thrown by constraints with the violation_action::throw_exception policy.
+ */
+struct constraint_violation : std::domain_error {
+    using std::domain_error::domain_error;
+};
+
+namespace detail {
+
+/**
+ * @brief Number of active suspend_checks guards on this thread.
+ */
+inline thread_local unsigned checks_suspended = 0;
+
+template<typename C>
+constexpr bool nothrow_checks = check_policy_of<C>::type::mode == check_mode::none ||
+    check_policy_of<C>::type::action != violation_action::throw_exception;
+
+template<typename C>
+void report_violation(const C& c) {
+    std::ostringstream message;
+    message << "Constraint violated: " << c;
+
+    using policy = typename check_policy_of<C>::type;
+    if constexpr (policy::action == violation_action::throw_exception) {
+        throw constraint_violation{ message.str() };
+    }
+    else if constexpr (policy::action == violation_action::log) {
+        std::clog << message.str() << std::endl;
+    }
+    else {
+        std::cerr << message.str() << std::endl;
+        std::abort();
+    }
+}
+
+template<typename C>
+constexpr void check(const C& c) {
+    if constexpr (requires { c.is_valid(); }) {
+        // Constant evaluation is left out, where static_test_func constructs invalid results on purpose.
+        if (!std::is_constant_evaluated() && checks_suspended == 0 && !c.is_valid()) [[unlikely]] report_violation(c);
+    }
+}
+
+/**
+ * @brief Check after a constraint was constructed from a raw value.
+ */
+template<typename C>
+constexpr void check_construction(const C& c) noexcept(nothrow_checks<C>) {
+    if constexpr (check_policy_of<C>::type::mode != check_mode::none) check(c);
+}
+
+/**
+ * @brief Check after a constraint was constructed from a value, whose interval [LO, HI] was derived at compile time.
+ *        The check is left out if the interval lies inside the constraint, see interval_arithmetic.hpp.
+ */
+template<auto LO, auto HI, typename C>
+constexpr void check_derived(const C& c) noexcept(nothrow_checks<C>);
+
+/**
+ * @brief Check after the value of a constraint was modified in place.
+ */
+template<typename C>
+constexpr void check_modification(const C& c) noexcept(nothrow_checks<C>) {
+    if constexpr (check_policy_of<C>::type::mode == check_mode::always) check(c);
+}
+
+}
+
+/**
+ * @brief Suspends all checks on the current thread while it is alive.
+ *
+ * The test generators run the function under test with this guard, because invalid results are what they look for.
+ */
+struct suspend_checks {
+    suspend_checks() noexcept { ++detail::checks_suspended; }
+    ~suspend_checks() { --detail::checks_suspended; }
+
+    suspend_checks(const suspend_checks&) = delete;
+    suspend_checks& operator=(const suspend_checks&) = delete;
+};
+
+}
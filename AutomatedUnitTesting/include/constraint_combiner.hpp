@@ -1,23 +1,41 @@
 #pragma once
 
 #include "constraint_proxy.hpp"
+#include "interval_set.hpp"
+#include "interval_arithmetic.hpp"
 
 namespace aut {
 
 /**
  * @brief Combines two constraints with AND condition.
- * @tparam A 
- * @tparam B 
+ *
+ * If both constraints have an interval form, the combination is checked against its interval form.
+ * @tparam A
+ * @tparam B
 */
 template<typename A, typename B> requires is_constrained<A> && is_constrained<B>
 struct _and : public constraint_proxy<typename A::value_type> {
     using constraint_proxy<typename A::value_type>::constraint_proxy;
 
-    constexpr bool is_valid() const { return A{ this->m_t }.is_valid() && B{ this->m_t }.is_valid(); }
+    constexpr _and(const typename A::value_type& t) noexcept(detail::nothrow_checks<_and>) : constraint_proxy<typename A::value_type>(t) {
+        detail::check_construction(*this);
+    }
+
+    template<auto LO, auto HI>
+    constexpr _and(const bounded<LO, HI, typename A::value_type>& b) noexcept(detail::nothrow_checks<_and>) : constraint_proxy<typename A::value_type>(b.m_t) {
+        detail::check_derived<LO, HI>(*this);
+    }
+
+    constexpr bool is_valid() const {
+        if constexpr (has_intervals<_and>) return detail::interval_check<_and>::contains(this->m_t);
+        else return A{ unchecked, this->m_t }.is_valid() && B{ unchecked, this->m_t }.is_valid();
+    }
 };
 
 /**
  * @brief Combines two constraints with OR condition.
+ *
+ * If both constraints have an interval form, the combination is checked against its interval form.
  * @tparam A
  * @tparam B
 */
@@ -25,18 +43,73 @@ template<typename A, typename B> requires is_constrained<A> && is_constrained<B>
 struct _or : public constraint_proxy<typename A::value_type> {
     using constraint_proxy<typename A::value_type>::constraint_proxy;
 
-    constexpr bool is_valid() const { return A{ this->m_t }.is_valid() || B { this->m_t }.is_valid(); }
+    constexpr _or(const typename A::value_type& t) noexcept(detail::nothrow_checks<_or>) : constraint_proxy<typename A::value_type>(t) {
+        detail::check_construction(*this);
+    }
+
+    template<auto LO, auto HI>
+    constexpr _or(const bounded<LO, HI, typename A::value_type>& b) noexcept(detail::nothrow_checks<_or>) : constraint_proxy<typename A::value_type>(b.m_t) {
+        detail::check_derived<LO, HI>(*this);
+    }
+
+    constexpr bool is_valid() const {
+        if constexpr (has_intervals<_or>) return detail::interval_check<_or>::contains(this->m_t);
+        else return A{ unchecked, this->m_t }.is_valid() || B{ unchecked, this->m_t }.is_valid();
+    }
 };
 
 /**
  * @brief Negates a given constraint.
+ *
+ * If the constraint has an interval form, the negation is checked against the complement of the interval form.
  * @tparam A
 */
 template<typename A> requires is_constrained<A>
 struct _not : public constraint_proxy<typename A::value_type> {
     using constraint_proxy<typename A::value_type>::constraint_proxy;
 
-    constexpr bool is_valid() const { return !A{ this->m_t }.is_valid(); }
+    constexpr _not(const typename A::value_type& t) noexcept(detail::nothrow_checks<_not>) : constraint_proxy<typename A::value_type>(t) {
+        detail::check_construction(*this);
+    }
+
+    template<auto LO, auto HI>
+    constexpr _not(const bounded<LO, HI, typename A::value_type>& b) noexcept(detail::nothrow_checks<_not>) : constraint_proxy<typename A::value_type>(b.m_t) {
+        detail::check_derived<LO, HI>(*this);
+    }
+
+    constexpr bool is_valid() const {
+        if constexpr (has_intervals<_not>) return detail::interval_check<_not>::contains(this->m_t);
+        else return !A{ unchecked, this->m_t }.is_valid();
+    }
+};
+
+namespace detail {
+
+template<typename A, typename B>
+concept same_interval_type = has_intervals<A> && has_intervals<B> &&
+    std::same_as<typename intervals_of<A>::value_type, typename intervals_of<B>::value_type>;
+
+}
+
+template<typename A, typename B> requires detail::same_interval_type<A, B>
+struct intervals_of<_and<A, B>> {
+    using value_type = typename intervals_of<A>::value_type;
+    static constexpr auto set = detail::intersect(intervals_of<A>::value, intervals_of<B>::value);
+    static constexpr auto value = detail::shrink<set.size>(set);
+};
+
+template<typename A, typename B> requires detail::same_interval_type<A, B>
+struct intervals_of<_or<A, B>> {
+    using value_type = typename intervals_of<A>::value_type;
+    static constexpr auto set = detail::unite(intervals_of<A>::value, intervals_of<B>::value);
+    static constexpr auto value = detail::shrink<set.size>(set);
+};
+
+template<typename A> requires has_intervals<A>
+struct intervals_of<_not<A>> {
+    using value_type = typename intervals_of<A>::value_type;
+    static constexpr auto set = detail::complement(intervals_of<A>::value);
+    static constexpr auto value = detail::shrink<set.size>(set);
 };
 
-}
\ No newline at end of file
+}
@@ -4,6 +4,8 @@
 #include <functional>
 #include <concepts>
 
+#include "check_policy.hpp"
+
 namespace aut {
 
     template <typename T>
@@ -18,6 +20,15 @@ namespace aut {
     template<typename T, typename U>
     concept at_least_one_constrained = is_constrained<T> || is_constrained<U>;
 
+    /**
+     * @brief Tag to construct a constraint without checking its value, regardless of the check policy.
+     */
+    struct unchecked_t {};
+    inline constexpr unchecked_t unchecked{};
+
+    template<auto LO, auto HI, typename T = decltype(LO)>
+    struct bounded;
+
     template<auto VAL, typename T>
     concept is_numeric_and_same_type = Numeric<decltype(VAL)> && std::same_as<decltype(VAL), T>;
 
@@ -41,6 +52,12 @@ namespace aut {
         */
         constexpr constraint_proxy(const T& t) noexcept(std::is_nothrow_constructible_v<T>) : m_t(t) {}
 
+        /**
+         * @brief Constructor which never checks the value, e.g. to probe values which may be invalid.
+         * @param t Data to be wrapped in the proxy class.
+        */
+        constexpr constraint_proxy(unchecked_t, const T& t) noexcept(std::is_nothrow_constructible_v<T>) : m_t(t) {}
+
         /**
          * @brief Default-constructor is deleted, as an initialization of the wrapped data is necessary
         */
@@ -53,42 +70,6 @@ namespace aut {
         constraint_proxy<T>& operator=(const constraint_proxy<T>& other) noexcept(std::is_nothrow_copy_assignable_v<T>) = default;
 
 
-        /**
-         * @brief Pre-increment operator
-         * @return
-        */
-        constexpr inline auto& operator++() {
-            ++m_t;
-            return *this;
-        }
-
-        /**
-         * @brief Post-increment operator
-         * @return
-        */
-        constexpr inline auto& operator++(int) {
-            constraint_proxy<T> tmp(*this);
-            operator++();
-            return tmp;
-        }
-        /**
-         * @brief Pre-decrement operator
-         * @return 
-        */
-        constexpr inline auto& operator--() {
-            --m_t;
-            return *this;
-        }
-        /**
-         * @brief Post-decrement operator
-         * @return
-        */
-        constexpr inline auto& operator--(int) {
-            constraint_proxy<T> tmp(*this);
-            operator--();
-            return tmp;
-        }
-
         /**
          * @brief Implicit cast operator in order to avoid manual 
          *        casting when using the proxy inside a calculation.
@@ -103,6 +84,50 @@ namespace aut {
         T m_t;
     };
 
+/**
+ * @brief Pre-increment operator
+ * @return
+*/
+template<typename C> requires is_constrained<C>
+constexpr inline C& operator++(C& c) noexcept(detail::nothrow_checks<C>) {
+    ++c.m_t;
+    detail::check_modification(c);
+    return c;
+}
+
+/**
+ * @brief Post-increment operator
+ * @return
+*/
+template<typename C> requires is_constrained<C>
+constexpr inline C operator++(C& c, int) noexcept(detail::nothrow_checks<C>) {
+    C tmp(c);
+    ++c;
+    return tmp;
+}
+
+/**
+ * @brief Pre-decrement operator
+ * @return
+*/
+template<typename C> requires is_constrained<C>
+constexpr inline C& operator--(C& c) noexcept(detail::nothrow_checks<C>) {
+    --c.m_t;
+    detail::check_modification(c);
+    return c;
+}
+
+/**
+ * @brief Post-decrement operator
+ * @return
+*/
+template<typename C> requires is_constrained<C>
+constexpr inline C operator--(C& c, int) noexcept(detail::nothrow_checks<C>) {
+    C tmp(c);
+    --c;
+    return tmp;
+}
+
 /**
  * @brief Wrapper implementation for operations between proxy and non-proxy data.
  * 
@@ -163,10 +188,14 @@ template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline auto& operator+=(T2& lhs, const U2& rhs) {
     if constexpr (is_constrained<T2>) {
         if constexpr (is_constrained<U2>) {
-            return lhs.m_t += rhs.m_t;
+            lhs.m_t += rhs.m_t;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
         else {
-            return lhs.m_t += rhs;
+            lhs.m_t += rhs;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
     }
     else {
@@ -183,10 +212,14 @@ template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline auto& operator-=(T2& lhs, const U2& rhs) {
     if constexpr (is_constrained<T2>) {
         if constexpr (is_constrained<U2>) {
-            return lhs.m_t -= rhs.m_t;
+            lhs.m_t -= rhs.m_t;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
         else {
-            return lhs.m_t -= rhs;
+            lhs.m_t -= rhs;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
     }
     else {
@@ -203,10 +236,14 @@ template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline auto& operator*=(T2& lhs, const U2& rhs) {
     if constexpr (is_constrained<T2>) {
         if constexpr (is_constrained<U2>) {
-            return lhs.m_t *= rhs.m_t;
+            lhs.m_t *= rhs.m_t;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
         else {
-            return lhs.m_t *= rhs;
+            lhs.m_t *= rhs;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
     }
     else {
@@ -222,10 +259,14 @@ template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline auto& operator/=(T2& lhs, const U2& rhs) {
     if constexpr (is_constrained<T2>) {
         if constexpr (is_constrained<U2>) {
-            return lhs.m_t /= rhs.m_t;
+            lhs.m_t /= rhs.m_t;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
         else {
-            return lhs.m_t /= rhs;
+            lhs.m_t /= rhs;
+            detail::check_modification(lhs);
+            return lhs.m_t;
         }
     }
     else {
@@ -245,7 +286,7 @@ constexpr inline bool operator==(T2&& lhs, U2&& rhs) {
 
 template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline bool operator!=(T2&& lhs, U2&& rhs) {
-    return !(lhs == rhs);
+    return op_wrapper < T2, U2, std::not_equal_to > (lhs, rhs);
 }
 
 template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
@@ -255,16 +296,16 @@ constexpr inline bool operator<(T2&& lhs, U2&& rhs) {
 
 template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline bool operator>(T2&& lhs, U2&& rhs) {
-    return rhs < lhs;
+    return op_wrapper < T2, U2, std::greater > (lhs, rhs);
 }
 
 template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline bool operator>=(T2&& lhs, U2&& rhs) {
-    return !(lhs < rhs);
+    return op_wrapper < T2, U2, std::greater_equal > (lhs, rhs);
 }
 
 template<typename T2, typename U2> requires at_least_one_constrained<T2, U2>
 constexpr inline bool operator<=(T2&& lhs, U2&& rhs) {
-    return !(lhs > rhs);
+    return op_wrapper < T2, U2, std::less_equal > (lhs, rhs);
 }
 }
\ No newline at end of file
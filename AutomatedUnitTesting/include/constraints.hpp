@@ -1,6 +1,7 @@
 #pragma once
 
 #include "constraint_proxy.hpp"
+#include "one_of_lookup.hpp"
 #include <array>
 #include <iostream>
 
@@ -15,6 +16,15 @@ namespace aut {
         struct less : public constraint_proxy<T> {
         using constraint_proxy<T>::constraint_proxy;
 
+        constexpr less(const T& t) noexcept(detail::nothrow_checks<less>) : constraint_proxy<T>(t) {
+            detail::check_construction(*this);
+        }
+
+        template<auto LO, auto HI>
+        constexpr less(const bounded<LO, HI, T>& b) noexcept(detail::nothrow_checks<less>) : constraint_proxy<T>(b.m_t) {
+            detail::check_derived<LO, HI>(*this);
+        }
+
         constexpr bool is_valid() const { return this->m_t < THRESHOLD; }
     };
 
@@ -42,6 +52,15 @@ namespace aut {
         struct greater : public constraint_proxy<T> {
         using constraint_proxy<T>::constraint_proxy;
 
+        constexpr greater(const T& t) noexcept(detail::nothrow_checks<greater>) : constraint_proxy<T>(t) {
+            detail::check_construction(*this);
+        }
+
+        template<auto LO, auto HI>
+        constexpr greater(const bounded<LO, HI, T>& b) noexcept(detail::nothrow_checks<greater>) : constraint_proxy<T>(b.m_t) {
+            detail::check_derived<LO, HI>(*this);
+        }
+
         constexpr bool is_valid() const { return this->m_t > THRESHOLD; }
     };
 
@@ -69,6 +88,15 @@ namespace aut {
         struct greater_eq : public constraint_proxy<T> {
         using constraint_proxy<T>::constraint_proxy;
 
+        constexpr greater_eq(const T& t) noexcept(detail::nothrow_checks<greater_eq>) : constraint_proxy<T>(t) {
+            detail::check_construction(*this);
+        }
+
+        template<auto LO, auto HI>
+        constexpr greater_eq(const bounded<LO, HI, T>& b) noexcept(detail::nothrow_checks<greater_eq>) : constraint_proxy<T>(b.m_t) {
+            detail::check_derived<LO, HI>(*this);
+        }
+
         constexpr bool is_valid() const { return this->m_t >= THRESHOLD; }
     };
 
@@ -96,6 +124,15 @@ namespace aut {
         struct less_eq : public constraint_proxy<T> {
         using constraint_proxy<T>::constraint_proxy;
 
+        constexpr less_eq(const T& t) noexcept(detail::nothrow_checks<less_eq>) : constraint_proxy<T>(t) {
+            detail::check_construction(*this);
+        }
+
+        template<auto LO, auto HI>
+        constexpr less_eq(const bounded<LO, HI, T>& b) noexcept(detail::nothrow_checks<less_eq>) : constraint_proxy<T>(b.m_t) {
+            detail::check_derived<LO, HI>(*this);
+        }
+
         constexpr bool is_valid() const { return this->m_t <= THRESHOLD; }
     };
 
@@ -125,6 +162,15 @@ namespace aut {
         struct in_range : public constraint_proxy<T> {
         using constraint_proxy<T>::constraint_proxy;
 
+        constexpr in_range(const T& t) noexcept(detail::nothrow_checks<in_range>) : constraint_proxy<T>(t) {
+            detail::check_construction(*this);
+        }
+
+        template<auto LO, auto HI>
+        constexpr in_range(const bounded<LO, HI, T>& b) noexcept(detail::nothrow_checks<in_range>) : constraint_proxy<T>(b.m_t) {
+            detail::check_derived<LO, HI>(*this);
+        }
+
         constexpr bool is_valid() const { return this->m_t >= MIN && this->m_t <= MAX; }
     };
 
@@ -153,15 +199,22 @@ namespace aut {
         struct one_of : public constraint_proxy<decltype(Option0)> {
         using constraint_proxy<decltype(Option0)>::constraint_proxy;
 
+        constexpr one_of(const decltype(Option0)& t) noexcept(detail::nothrow_checks<one_of>) : constraint_proxy<decltype(Option0)>(t) {
+            detail::check_construction(*this);
+        }
 
-        constexpr bool is_valid() const { 
-            constexpr std::array<decltype(Option0), 1+sizeof...(Options)> options = {Option0, Options...};
-
-            for (const auto o : options) {
-                if (this->m_t == o) return true;
-            }
-            return false;
+        template<auto LO, auto HI>
+        constexpr one_of(const bounded<LO, HI, decltype(Option0)>& b) noexcept(detail::nothrow_checks<one_of>) : constraint_proxy<decltype(Option0)>(b.m_t) {
+            detail::check_derived<LO, HI>(*this);
         }
+
+        /**
+         * @brief Lookup of the value in the options. The lookup strategy is selected at compile time from the options,
+         *        see lookup_strategy.
+         */
+        using lookup = detail::one_of_lookup<decltype(Option0), Option0, Options...>;
+
+        constexpr bool is_valid() const { return lookup::contains(this->m_t); }
     };
 
     /**
@@ -0,0 +1,450 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <ostream>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "evaluation.hpp"
+#include "random_space.hpp"
+
+namespace aut {
+
+/**
+ * @brief How the elements of a generated container are filled.
+ */
+enum class fill_pattern : uint8_t {
+    /**
+     * @brief All elements are the same border value of the element constraint.
+     */
+    constant,
+    /**
+     * @brief The elements cycle through all border values of the element constraint.
+     */
+    alternating,
+    /**
+     * @brief Random values from the inside of the element domain, see domain_sampler.
+     */
+    interior,
+    /**
+     * @brief Like interior, sorted in ascending order.
+     */
+    ascending,
+    /**
+     * @brief Like interior, sorted in descending order.
+     */
+    descending
+};
+
+/**
+ * @brief Candidate value of a container argument: its size and how its elements are filled.
+ *
+ * Only this small descriptor is stored in the case tuples. The container itself is built right before each call of the
+ * function under test. The random values of a pattern are derived from the size and the pattern alone, so a case is
+ * reproducible from its descriptor.
+ *
+ * @tparam Container Container type of the argument.
+ */
+template<typename Container>
+struct container_case {
+    size_t size = 0;
+    fill_pattern pattern = fill_pattern::constant;
+    /**
+     * @brief Index of the border value of the element constraint for fill_pattern::constant.
+     */
+    size_t value = 0;
+
+    constexpr bool operator==(const container_case&) const = default;
+};
+
+/**
+ * @brief Size constraint of a container argument, whose border values are the tested sizes. By default, containers are
+ *        tested empty, with one, with two and with 16 elements. Specialize it for a container type to test other sizes:
+ *        template<> struct aut::container_size_of<std::vector<my_constraint>> { using type = aut::in_range<1, 64>; };
+ *
+ * Containers with a size fixed by their type, i.e. std::array and std::span with a static extent, are only tested with
+ * that size.
+ *
+ * @tparam Container Container type without cv- and reference qualifiers.
+ */
+template<typename Container>
+struct container_size_of {
+    using type = one_of<size_t{ 0 }, size_t{ 1 }, size_t{ 2 }, size_t{ 16 }>;
+};
+
+template<typename E, size_t N>
+struct container_size_of<std::array<E, N>> {
+    using type = one_of<N>;
+};
+
+template<typename E, size_t N> requires (N != std::dynamic_extent)
+struct container_size_of<std::span<E, N>> {
+    using type = one_of<N>;
+};
+
+namespace detail {
+
+/**
+ * @brief Element type of the supported container types.
+ */
+template<typename T>
+struct container_traits {};
+
+template<typename E, typename Allocator>
+struct container_traits<std::vector<E, Allocator>> {
+    using element_type = E;
+};
+
+template<typename E, size_t N>
+struct container_traits<std::array<E, N>> {
+    using element_type = E;
+};
+
+template<typename E, size_t N>
+struct container_traits<std::span<E, N>> {
+    using element_type = std::remove_const_t<E>;
+};
+
+template<typename T>
+concept container_argument = requires { typename container_traits<T>::element_type; } &&
+    is_constrained<typename container_traits<T>::element_type>;
+
+template<typename T>
+struct is_container_case : std::false_type {};
+
+template<typename Container>
+struct is_container_case<container_case<Container>> : std::true_type {};
+
+/**
+ * @brief Candidate values of a container argument: each size of the size constraint with each fill pattern.
+ *
+ * An empty container is only generated once. Single elements are not sorted, and cycling through the border values
+ * needs at least two of them.
+ */
+template<typename Container>
+struct container_candidates {
+    using element_type = typename container_traits<Container>::element_type;
+    using size_constraint = typename container_size_of<Container>::type;
+
+    static constexpr auto& sizes = evaluate<size_constraint>::valid_border_values;
+    static constexpr size_t num_borders = std::size(evaluate<element_type>::valid_border_values);
+
+    template<typename Emit>
+    static constexpr void for_each(Emit&& emit) {
+        for (const auto s : sizes) {
+            static_assert(std::is_integral_v<std::remove_cvref_t<decltype(s)>>, "Container sizes must be integers!");
+            const auto size = static_cast<size_t>(s);
+            if (size == 0) {
+                emit(container_case<Container>{ 0, fill_pattern::constant, 0 });
+                continue;
+            }
+            for (size_t v = 0; v < num_borders; v++) emit(container_case<Container>{ size, fill_pattern::constant, v });
+            if (size > 1 && num_borders > 1) emit(container_case<Container>{ size, fill_pattern::alternating, 0 });
+            emit(container_case<Container>{ size, fill_pattern::interior, 0 });
+            if (size > 1) {
+                emit(container_case<Container>{ size, fill_pattern::ascending, 0 });
+                emit(container_case<Container>{ size, fill_pattern::descending, 0 });
+            }
+        }
+    }
+
+    static constexpr size_t count = [] {
+        size_t n = 0;
+        for_each([&n](const auto&) { n++; });
+        return n;
+    }();
+
+    static constexpr std::array<container_case<Container>, count> values = [] {
+        std::array<container_case<Container>, count> v{};
+        size_t n = 0;
+        for_each([&](const auto& c) { v[n++] = c; });
+        return v;
+    }();
+};
+
+/**
+ * @brief Border values of container arguments, see container_candidates.
+ */
+template<typename Container>
+struct evaluate_container {
+    static_assert(std::is_trivially_destructible_v<typename container_traits<Container>::element_type>,
+                  "Container elements must be trivially destructible constraints!");
+    using value_type = container_case<Container>;
+    static constexpr auto valid_border_values = container_candidates<Container>::values;
+};
+
+}
+
+template<typename E, typename Allocator> requires is_constrained<E>
+struct evaluate<std::vector<E, Allocator>> : detail::evaluate_container<std::vector<E, Allocator>> {};
+
+template<typename E, size_t N> requires is_constrained<E>
+struct evaluate<std::array<E, N>> : detail::evaluate_container<std::array<E, N>> {};
+
+template<typename E, size_t N> requires is_constrained<std::remove_const_t<E>>
+struct evaluate<std::span<E, N>> : detail::evaluate_container<std::span<E, N>> {};
+
+/**
+ * @brief Prints the descriptor of a container, e.g. [16 x 100] for 16 elements of value 100 or [16, ascending].
+ */
+template<typename Container>
+std::ostream& operator<<(std::ostream& os, const container_case<Container>& c) {
+    using element_type = typename detail::container_traits<Container>::element_type;
+    os << "[" << c.size;
+    if (c.size == 0) return os << "]";
+    switch (c.pattern) {
+    case fill_pattern::constant: return os << " x " << evaluate<element_type>::valid_border_values[c.value] << "]";
+    case fill_pattern::alternating: return os << ", alternating]";
+    case fill_pattern::interior: return os << ", interior]";
+    case fill_pattern::ascending: return os << ", ascending]";
+    case fill_pattern::descending: return os << ", descending]";
+    }
+    return os << "]";
+}
+
+namespace detail {
+
+/**
+ * @brief Memory of the containers of a case, which is released all at once before the next case.
+ *
+ * Allocations bump a pointer through a block. If a case needs more than the block, further blocks are chained, and the
+ * next reset() merges them into a single block of the total size. After the largest case, no case allocates memory from
+ * the global allocator anymore.
+ */
+class case_arena final : public std::pmr::memory_resource {
+public:
+    explicit case_arena(size_t initial_size = 64 * 1024) : m_initial_size(initial_size) {}
+
+    case_arena(const case_arena&) = delete;
+    case_arena& operator=(const case_arena&) = delete;
+
+    /**
+     * @brief Releases all allocations of the current case.
+     */
+    void reset() {
+        if (m_blocks.size() > 1) {
+            size_t total = 0;
+            for (const auto& b : m_blocks) total += b.size;
+            m_blocks.clear();
+            add_block(total);
+        }
+        m_used = 0;
+    }
+
+    /**
+     * @brief Number of blocks, which were allocated from the global allocator so far.
+     */
+    size_t block_allocations() const { return m_block_allocations; }
+
+private:
+    struct block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    void add_block(size_t size) {
+        m_blocks.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+        m_block_allocations++;
+        m_used = 0;
+    }
+
+    /**
+     * @brief Offset of the first address at or after used, which is aligned. The blocks only have the alignment of
+     *        operator new, so the address is aligned instead of the offset.
+     */
+    static size_t aligned_offset(const block& b, size_t used, size_t alignment) {
+        const auto address = reinterpret_cast<uintptr_t>(b.data.get()) + used;
+        return used + (alignment - address % alignment) % alignment;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (!m_blocks.empty()) {
+            const block& b = m_blocks.back();
+            const size_t offset = aligned_offset(b, m_used, alignment);
+            if (offset + bytes <= b.size) {
+                m_used = offset + bytes;
+                return b.data.get() + offset;
+            }
+        }
+        const size_t last = m_blocks.empty() ? m_initial_size / 2 : m_blocks.back().size;
+        add_block(std::max(2 * last, bytes + alignment));
+        const size_t offset = aligned_offset(m_blocks.back(), 0, alignment);
+        m_used = offset + bytes;
+        return m_blocks.back().data.get() + offset;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    size_t m_initial_size;
+    std::vector<block> m_blocks;
+    size_t m_used = 0;
+    size_t m_block_allocations = 0;
+};
+
+/**
+ * @brief Arena of the calling worker thread or process.
+ */
+inline case_arena& thread_arena() {
+    thread_local case_arena arena;
+    return arena;
+}
+
+/**
+ * @brief Computes the element values of a container case and passes them to emit in order.
+ */
+template<typename Container, typename Emit>
+void fill_container(const container_case<Container>& c, case_arena& arena, Emit&& emit) {
+    using element_type = typename container_traits<Container>::element_type;
+    using value_type = typename element_type::value_type;
+    constexpr auto& borders = evaluate<element_type>::valid_border_values;
+
+    switch (c.pattern) {
+    case fill_pattern::constant:
+        for (size_t i = 0; i < c.size; i++) emit(borders[c.value]);
+        return;
+    case fill_pattern::alternating:
+        for (size_t i = 0; i < c.size; i++) emit(borders[i % std::size(borders)]);
+        return;
+    default:
+        break;
+    }
+
+    auto rng = case_rng(c.size, static_cast<uint64_t>(c.pattern));
+    std::pmr::vector<value_type> values(&arena);
+    values.reserve(c.size);
+    for (size_t i = 0; i < c.size; i++) values.push_back(domain_sampler<element_type>::sample(rng, 0.));
+    if (c.pattern != fill_pattern::interior) {
+        const auto less = [](const value_type& a, const value_type& b) {
+            if constexpr (interval_type<value_type>) return to_key(a) < to_key(b);
+            else return a < b;
+        };
+        std::sort(values.begin(), values.end(), less);
+        if (c.pattern == fill_pattern::descending) std::reverse(values.begin(), values.end());
+    }
+    for (const auto& v : values) emit(v);
+}
+
+/**
+ * @brief Argument of a call, which is passed on as it is.
+ */
+template<size_t I, typename V>
+struct argument_holder {
+    const V& value;
+
+    argument_holder(const V& v, case_arena&) : value(v) {}
+    const V& get() const { return value; }
+};
+
+/**
+ * @brief std::vector with the default allocator. Its allocator cannot use the arena, so each argument position reuses
+ *        one vector per thread, whose capacity is kept from case to case.
+ */
+template<size_t I, typename E>
+struct argument_holder<I, container_case<std::vector<E>>> {
+    std::vector<E>* container;
+
+    argument_holder(const container_case<std::vector<E>>& c, case_arena& arena) {
+        thread_local std::vector<E> buffer;
+        container = &buffer;
+        buffer.clear();
+        buffer.reserve(c.size);
+        fill_container(c, arena, [this](const auto& v) { container->emplace_back(unchecked, v); });
+    }
+    std::vector<E>& get() { return *container; }
+};
+
+/**
+ * @brief std::pmr::vector, which allocates from the arena.
+ */
+template<size_t I, typename E>
+struct argument_holder<I, container_case<std::vector<E, std::pmr::polymorphic_allocator<E>>>> {
+    std::pmr::vector<E> container;
+
+    argument_holder(const container_case<std::pmr::vector<E>>& c, case_arena& arena) : container(&arena) {
+        container.reserve(c.size);
+        fill_container(c, arena, [this](const auto& v) { container.emplace_back(unchecked, v); });
+    }
+    std::pmr::vector<E>& get() { return container; }
+};
+
+/**
+ * @brief std::span over elements in the arena.
+ */
+template<size_t I, typename E, size_t N>
+struct argument_holder<I, container_case<std::span<E, N>>> {
+    using element_type = std::remove_const_t<E>;
+    std::span<E, N> container;
+
+    argument_holder(const container_case<std::span<E, N>>& c, case_arena& arena) {
+        auto* data = static_cast<element_type*>(arena.allocate(std::max<size_t>(c.size, 1) * sizeof(element_type), alignof(element_type)));
+        size_t n = 0;
+        fill_container(c, arena, [&](const auto& v) { std::construct_at(data + n++, unchecked, v); });
+        container = std::span<E, N>(data, c.size);
+    }
+    std::span<E, N>& get() { return container; }
+};
+
+/**
+ * @brief std::array, which lives in the holder.
+ */
+template<size_t I, typename E, size_t N>
+struct argument_holder<I, container_case<std::array<E, N>>> {
+    std::array<E, N> container;
+
+    argument_holder(const container_case<std::array<E, N>>& c, case_arena& arena)
+        : container(make(c, arena, std::make_index_sequence<N>{})) {}
+    std::array<E, N>& get() { return container; }
+
+private:
+    template<size_t... Is>
+    static std::array<E, N> make(const container_case<std::array<E, N>>& c, case_arena& arena, std::index_sequence<Is...>) {
+        using value_type = typename E::value_type;
+        std::array<value_type, N> values{};
+        size_t n = 0;
+        fill_container(c, arena, [&](const value_type& v) { values[n++] = v; });
+        return { E{ unchecked, values[Is] }... };
+    }
+};
+
+template<typename Tuple>
+struct has_container_arguments;
+
+template<typename... V>
+struct has_container_arguments<std::tuple<V...>> : std::bool_constant<(is_container_case<V>::value || ...)> {};
+
+template<typename Func, typename Tuple, size_t... Is>
+decltype(auto) apply_materialized(Func&& func, const Tuple& args, std::index_sequence<Is...>) {
+    case_arena& arena = thread_arena();
+    arena.reset();
+    std::tuple<argument_holder<Is, std::tuple_element_t<Is, Tuple>>...> holders{ { std::get<Is>(args), arena }... };
+    return std::forward<Func>(func)(std::get<Is>(holders).get()...);
+}
+
+/**
+ * @brief Calls a function with the argument values of a case. Container arguments are built from their descriptors
+ *        first, in the arena of the calling thread, which is reset for each call.
+ */
+template<typename Func, typename Tuple>
+decltype(auto) apply_case(Func&& func, const Tuple& args) {
+    if constexpr (has_container_arguments<Tuple>::value) {
+        return apply_materialized(std::forward<Func>(func), args, std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+    }
+    else {
+        return std::apply(std::forward<Func>(func), args);
+    }
+}
+
+}
+
+}
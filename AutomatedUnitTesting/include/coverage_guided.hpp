@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "evaluation.hpp"
+#include "interval_set.hpp"
+#include "random_space.hpp"
+
+// Define the callbacks of -fsanitize-coverage=trace-pc (GCC and Clang) and trace-pc-guard (Clang), e.g. by setting the
+// AUT_COVERAGE_GUIDED CMake option. Off by default, as other coverage tools like libFuzzer define them as well.
+#ifndef AUT_COVERAGE_GUIDED
+#define AUT_COVERAGE_GUIDED 0
+#endif
+
+#if defined(__clang__)
+#define AUT_NO_COVERAGE __attribute__((no_sanitize("coverage")))
+#elif defined(__GNUC__) && __GNUC__ >= 12
+#define AUT_NO_COVERAGE __attribute__((no_sanitize_coverage))
+#else
+#define AUT_NO_COVERAGE
+#endif
+
+namespace aut {
+
+namespace detail {
+
+/**
+ * @brief Hit counts of the control flow edges of a single execution, as in AFL.
+ *
+ * An edge is identified by the hashed locations of the previous and the current basic block. Collisions only
+ * merge edges, so the map has a fixed size. The indices of the hit edges are listed as well, so clearing and merging
+ * only touch these instead of the whole map.
+ */
+struct edge_map {
+    static constexpr size_t size = size_t{ 1 } << 16;
+
+    std::array<uint8_t, size> hits{};
+    std::array<uint16_t, size> touched{};
+    size_t num_touched = 0;
+    uint32_t prev = 0;
+
+    void clear() {
+        for (size_t i = 0; i < num_touched; i++) hits[touched[i]] = 0;
+        num_touched = 0;
+        prev = 0;
+    }
+};
+
+/**
+ * @brief Map of the calling thread, which records the edges, or nullptr if the thread does not trace its execution.
+ */
+inline thread_local edge_map* active_edge_map = nullptr;
+
+AUT_NO_COVERAGE inline void record_location(uint64_t location) {
+    edge_map* map = active_edge_map;
+    if (map == nullptr) return;
+    const auto loc = static_cast<uint32_t>((location * 0x9e3779b97f4a7c15ull) >> 48);
+    const uint32_t edge = loc ^ map->prev;
+    uint8_t& h = map->hits[edge];
+    if (h == 0) map->touched[map->num_touched++] = static_cast<uint16_t>(edge);
+    h += h != 255;
+    map->prev = loc >> 1;
+}
+
+/**
+ * @brief Traces the edges of the calling thread into a map for the lifetime of the object.
+ */
+struct trace_edges {
+    explicit trace_edges(edge_map& map) : m_previous(active_edge_map) {
+        map.clear();
+        active_edge_map = &map;
+    }
+
+    ~trace_edges() { active_edge_map = m_previous; }
+
+    trace_edges(const trace_edges&) = delete;
+    trace_edges& operator=(const trace_edges&) = delete;
+
+private:
+    edge_map* m_previous;
+};
+
+/**
+ * @brief Coarse hit count classes of AFL, so loops only count as new behaviour if their trip count changes in magnitude.
+ */
+constexpr uint8_t hit_class(uint8_t hits) {
+    if (hits <= 2) return hits;
+    if (hits == 3) return 4;
+    if (hits < 8) return 8;
+    if (hits < 16) return 16;
+    if (hits < 32) return 32;
+    if (hits < 128) return 64;
+    return 128;
+}
+
+/**
+ * @brief Union of the hit count classes of all executions of a run.
+ */
+struct edge_coverage {
+    std::array<uint8_t, edge_map::size> seen{};
+    size_t edges = 0;
+
+    /**
+     * @brief Merges the classes of an execution and returns how many of them were not seen before.
+     */
+    size_t merge(const edge_map& map) {
+        size_t found = 0;
+        for (size_t i = 0; i < map.num_touched; i++) {
+            const uint16_t j = map.touched[i];
+            const uint8_t c = hit_class(map.hits[j]);
+            if ((c & ~seen[j]) == 0) continue;
+            edges += seen[j] == 0;
+            seen[j] |= c;
+            found++;
+        }
+        return found;
+    }
+};
+
+/**
+ * @brief Mutates a value of a constraint into another valid value.
+ *
+ * Constraints without an interval form switch to another of their border values.
+ *
+ * @tparam C Constraint type.
+ */
+template<typename C>
+struct value_mutator {
+    using value_type = typename evaluate<C>::value_type;
+
+    template<typename Rng>
+    static value_type mutate(const value_type&, Rng& rng) {
+        return domain_sampler<C>::sample(rng, 0.);
+    }
+};
+
+/**
+ * @brief Mutates the key (see to_key) of a value inside its interval: small steps, bit flips and byte replacements of
+ *        the offset to the lower bound, jumps next to an interval bound or to a random value of the domain.
+ */
+template<typename C> requires has_intervals<C>
+struct value_mutator<C> {
+    using sampler = domain_sampler<C>;
+    using value_type = typename sampler::value_type;
+    static constexpr const auto& set = sampler::set;
+
+    template<typename Rng>
+    static value_type mutate(const value_type& v, Rng& rng) {
+        const size_t i = sampler::find(v);
+        if (i == set.size) return sampler::sample(rng, 0.5);
+
+        const uint64_t lo = to_key(set.intervals[i].lo);
+        const uint64_t span = to_key(set.intervals[i].hi) - lo;
+        const uint64_t offset = to_key(v) - lo;
+        const uint64_t bits = std::max<uint64_t>(std::bit_width(span), 1);
+        uint64_t next = offset;
+        switch (rng.below(5)) {
+        case 0: {
+            const uint64_t step = 1 + rng.below(16);
+            if (rng.below(2) == 0) next = offset >= step ? offset - step : 0;
+            else next = span - offset >= step ? offset + step : span;
+            break;
+        }
+        case 1:
+            next = offset ^ (uint64_t{ 1 } << rng.below(bits));
+            break;
+        case 2: {
+            const uint64_t shift = 8 * rng.below((bits + 7) / 8);
+            next = (offset & ~(uint64_t{ 0xff } << shift)) | (rng.below(256) << shift);
+            break;
+        }
+        case 3:
+            return sampler::sample_boundary(rng);
+        default:
+            return sampler::sample(rng, 0.);
+        }
+        return from_key<value_type>(lo + std::min(next, span));
+    }
+};
+
+/**
+ * @brief Mutates argument tuples, so every argument stays inside the valid domain of its constraint.
+ */
+template<typename... Args>
+struct case_mutator {
+    template<typename Tuple, typename Rng>
+    static void mutate(Tuple& args, const Tuple& other, Rng& rng) {
+        mutate_impl(args, other, rng, std::index_sequence_for<Args...>{});
+    }
+
+private:
+    template<typename Tuple, typename Rng, size_t... Is>
+    static void mutate_impl(Tuple& args, const Tuple& other, Rng& rng, std::index_sequence<Is...>) {
+        if constexpr (sizeof...(Args) > 0) {
+            // Mostly a single argument, so the other ones keep reaching the edges of their parent input.
+            const uint64_t rounds = 1 + (rng.below(4) == 0 ? rng.below(sizeof...(Args)) : 0);
+            for (uint64_t r = 0; r < rounds; r++) {
+                const uint64_t arg = rng.below(sizeof...(Args));
+                // Takes the argument from another input of the corpus once in a while.
+                const bool cross = rng.below(8) == 0;
+                ((arg == Is ? void(std::get<Is>(args) = cross ? std::get<Is>(other)
+                    : value_mutator<std::remove_cvref_t<Args>>::mutate(std::get<Is>(args), rng)) : void()), ...);
+            }
+        }
+    }
+};
+
+template<typename T>
+struct case_mutator_of;
+
+template<template<typename...> typename C, typename... Args>
+struct case_mutator_of<C<Args...>> {
+    using type = case_mutator<Args...>;
+};
+
+}
+
+}
+
+#if AUT_COVERAGE_GUIDED && defined(__GNUC__)
+// Inline and used, so every translation unit, which includes this header, emits the callbacks as weak symbols for the
+// instrumented translation units.
+extern "C" {
+
+__attribute__((used)) AUT_NO_COVERAGE inline void __sanitizer_cov_trace_pc() {
+    aut::detail::record_location(reinterpret_cast<uintptr_t>(__builtin_return_address(0)));
+}
+
+__attribute__((used)) AUT_NO_COVERAGE inline void __sanitizer_cov_trace_pc_guard_init(uint32_t* start, uint32_t* stop) {
+    static uint32_t next = 0;
+    if (start == stop || *start != 0) return;
+    for (uint32_t* guard = start; guard < stop; guard++) *guard = ++next;
+}
+
+__attribute__((used)) AUT_NO_COVERAGE inline void __sanitizer_cov_trace_pc_guard(uint32_t* guard) {
+    aut::detail::record_location(*guard);
+}
+
+}
+#endif
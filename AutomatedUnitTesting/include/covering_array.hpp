@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace aut {
+
+/**
+ * @brief Selects which combinations of argument values are tested.
+ *
+ * The t-wise strategies generate a covering array: every combination of values of any t arguments
+ * appears in at least one test case, instead of every combination of values of all arguments.
+ */
+enum class coverage {
+    exhaustive = 0,
+    pairwise = 2,
+    three_wise = 3,
+};
+
+/**
+ * @brief Returns a printable name for a coverage strategy.
+ */
+constexpr const char* coverage_name(coverage c) {
+    switch (c) {
+    case coverage::pairwise: return "pairwise";
+    case coverage::three_wise: return "3-wise";
+    default: return "exhaustive";
+    }
+}
+
+namespace detail {
+
+/**
+ * @brief Converts per-argument value indices into a flat case index (last argument changes fastest).
+ */
+constexpr size_t flat_case_index(const std::vector<size_t>& radices, const std::vector<size_t>& digits) {
+    size_t index = 0;
+    for (size_t i = 0; i < radices.size(); i++) {
+        index = index * radices[i] + digits[i];
+    }
+    return index;
+}
+
+/**
+ * @brief Returns all subsets of size t of the arguments [0, n), in lexicographic order.
+ */
+constexpr std::vector<std::vector<size_t>> argument_combinations(size_t n, size_t t) {
+    std::vector<std::vector<size_t>> combinations;
+    std::vector<size_t> c(t);
+    for (size_t i = 0; i < t; i++) c[i] = i;
+
+    while (true) {
+        combinations.push_back(c);
+
+        size_t i = t;
+        while (i > 0 && c[i - 1] == n - t + i - 1) i--;
+        if (i == 0) break;
+        c[i - 1]++;
+        for (size_t j = i; j < t; j++) c[j] = c[j - 1] + 1;
+    }
+    return combinations;
+}
+
+}
+
+/**
+ * @brief Builds a t-wise covering array over arguments with the given number of candidate values.
+ *
+ * Greedy construction: each new test case starts from the first uncovered value combination, and the remaining
+ * arguments are assigned one after another with the value which covers the most new combinations.
+ * The result is deterministic and can be evaluated at compile time.
+ *
+ * @param radices Number of candidate values per argument.
+ * @param t Interaction strength. If t is 0 or not smaller than the number of arguments, all cases are returned.
+ * @return Returns the flat case indices (see case_space) of the selected cases in ascending order.
+ */
+constexpr std::vector<size_t> covering_array(const std::vector<size_t>& radices, size_t t) {
+    const size_t n = radices.size();
+    size_t total = 1;
+    for (const auto r : radices) total *= r;
+
+    std::vector<size_t> rows;
+    if (t == 0 || t >= n || total == 0) {
+        rows.resize(total);
+        for (size_t i = 0; i < total; i++) rows[i] = i;
+        return rows;
+    }
+
+    const auto combinations = detail::argument_combinations(n, t);
+
+    // One flag per value combination of each argument combination, true while uncovered.
+    std::vector<std::vector<bool>> uncovered;
+    size_t remaining = 0;
+    for (const auto& c : combinations) {
+        size_t sz = 1;
+        for (const auto a : c) sz *= radices[a];
+        uncovered.emplace_back(sz, true);
+        remaining += sz;
+    }
+
+    constexpr size_t unset = static_cast<size_t>(-1);
+    auto tuple_index = [&](const std::vector<size_t>& c, const std::vector<size_t>& digits) {
+        size_t index = 0;
+        for (const auto a : c) index = index * radices[a] + digits[a];
+        return index;
+    };
+    auto is_assigned = [&](const std::vector<size_t>& c, const std::vector<size_t>& digits) {
+        for (const auto a : c) {
+            if (digits[a] == unset) return false;
+        }
+        return true;
+    };
+
+    std::vector<size_t> digits(n);
+    while (remaining > 0) {
+        std::fill(digits.begin(), digits.end(), unset);
+
+        // Seed the case with the first uncovered value combination.
+        for (size_t ci = 0; ci < combinations.size(); ci++) {
+            const auto it = std::find(uncovered[ci].begin(), uncovered[ci].end(), true);
+            if (it == uncovered[ci].end()) continue;
+
+            size_t index = static_cast<size_t>(it - uncovered[ci].begin());
+            for (size_t k = t; k-- > 0;) {
+                const size_t a = combinations[ci][k];
+                digits[a] = index % radices[a];
+                index /= radices[a];
+            }
+            break;
+        }
+
+        for (size_t a = 0; a < n; a++) {
+            if (digits[a] != unset) continue;
+
+            size_t best_value = 0;
+            size_t best_gain = 0;
+            for (size_t v = 0; v < radices[a]; v++) {
+                digits[a] = v;
+                size_t gain = 0;
+                for (size_t ci = 0; ci < combinations.size(); ci++) {
+                    const auto& c = combinations[ci];
+                    if (std::find(c.begin(), c.end(), a) == c.end()) continue;
+                    if (!is_assigned(c, digits)) continue;
+                    if (uncovered[ci][tuple_index(c, digits)]) gain++;
+                }
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_value = v;
+                }
+            }
+            digits[a] = best_value;
+        }
+
+        for (size_t ci = 0; ci < combinations.size(); ci++) {
+            const size_t index = tuple_index(combinations[ci], digits);
+            if (uncovered[ci][index]) {
+                uncovered[ci][index] = false;
+                remaining--;
+            }
+        }
+        rows.push_back(detail::flat_case_index(radices, digits));
+    }
+
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+/**
+ * @brief Compile-time t-wise covering array over the cases of a case_space.
+ * @tparam Space case_space of the function under test.
+ * @tparam C Coverage strategy.
+ */
+template<typename Space, coverage C>
+struct covering_array_of {
+    static constexpr std::vector<size_t> build() {
+        return covering_array(std::vector<size_t>(Space::radices.begin(), Space::radices.end()), static_cast<size_t>(C));
+    }
+
+    /**
+     * @brief Number of selected cases.
+     */
+    static constexpr size_t size = build().size();
+
+    /**
+     * @brief Flat case indices of the selected cases.
+     */
+    static constexpr std::array<size_t, size> indices = [] {
+        const auto rows = build();
+        std::array<size_t, size> result{};
+        std::copy(rows.begin(), rows.end(), result.begin());
+        return result;
+    }();
+};
+
+}
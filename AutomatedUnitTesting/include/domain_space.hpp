@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "interval_set.hpp"
+#include "random_space.hpp"
+
+namespace aut {
+
+namespace detail {
+
+/**
+ * @brief Enumerates all valid values of a constraint with an interval form.
+ *
+ * The values are numbered in ascending order of their keys (see to_key), so consecutive floating point values are one
+ * ULP apart. NaN is the last value, if the constraint accepts it.
+ *
+ * @tparam C Constraint type.
+ */
+template<typename C>
+struct domain_values {
+    using value_type = typename intervals_of<C>::value_type;
+    static constexpr const auto& set = intervals_of<C>::value;
+    static_assert(set.size > 0 || set.nan, "The constraint does not accept any value.");
+
+    /**
+     * @brief Number of valid values. Domains with more than 2^64 - 1 values saturate at that number.
+     */
+    static constexpr uint64_t size = [] {
+        constexpr uint64_t max = std::numeric_limits<uint64_t>::max();
+        uint64_t n = set.nan ? 1 : 0;
+        for (size_t i = 0; i < set.size; i++) {
+            const uint64_t w = to_key(set.intervals[i].hi) - to_key(set.intervals[i].lo);
+            if (w == max || n > max - w - 1) return max;
+            n += w + 1;
+        }
+        return n;
+    }();
+
+    /**
+     * @brief Returns the valid value with the given number.
+     * @param index Number of the value in [0, size).
+     */
+    static constexpr value_type at(uint64_t index) {
+        for (size_t i = 0; i < set.size; i++) {
+            const uint64_t lo = to_key(set.intervals[i].lo);
+            const uint64_t w = to_key(set.intervals[i].hi) - lo;
+            if (index <= w) return from_key<value_type>(lo + index);
+            index -= w + 1;
+        }
+        return std::numeric_limits<value_type>::quiet_NaN();
+    }
+};
+
+}
+
+/**
+ * @brief Flat index space over the cartesian product of all valid values of all arguments.
+ *
+ * The counterpart of case_space for exhaustive testing of small domains, e.g. of 8 and 16 bit integers or of narrow
+ * floating point ranges. A case index is decomposed in a mixed radix system like in case_space, where the radix of
+ * each digit is the number of valid values of the corresponding argument. The last argument changes fastest.
+ *
+ * @tparam Args Constrained argument types of the function under test. All of them need an interval form.
+ */
+template<typename... Args>
+struct domain_space {
+    using value_tuple = std::tuple<typename intervals_of<std::remove_cvref_t<Args>>::value_type...>;
+
+    static constexpr size_t arity = sizeof...(Args);
+
+    /**
+     * @brief Number of valid values per argument.
+     */
+    static constexpr std::array<uint64_t, arity> radices{ detail::domain_values<std::remove_cvref_t<Args>>::size... };
+
+    /**
+     * @brief Number of test cases. Saturates at 2^64 - 1, if the product does not fit.
+     */
+    static constexpr uint64_t size = [] {
+        constexpr uint64_t max = std::numeric_limits<uint64_t>::max();
+        uint64_t n = 1;
+        for (const uint64_t r : radices) {
+            if (r != 0 && n > max / r) return max;
+            n *= r;
+        }
+        return n;
+    }();
+
+    /**
+     * @brief Returns the argument values of a single test case.
+     * @param index Index of the test case in [0, size).
+     * @return Returns a tuple with one value per argument.
+     */
+    static constexpr value_tuple at(uint64_t index) {
+        std::array<uint64_t, arity> d{};
+        for (size_t i = arity; i-- > 0;) {
+            d[i] = index % radices[i];
+            index /= radices[i];
+        }
+        return at_impl(d, std::index_sequence_for<Args...>{});
+    }
+
+private:
+    template<size_t... Is>
+    static constexpr value_tuple at_impl(const std::array<uint64_t, arity>& d, std::index_sequence<Is...>) {
+        return value_tuple{ detail::domain_values<std::remove_cvref_t<Args>>::at(d[Is])... };
+    }
+};
+
+namespace detail {
+
+template<typename T>
+struct domain_space_of;
+
+template<template<typename...> typename C, typename... Args>
+struct domain_space_of<C<Args...>> {
+    using type = domain_space<Args...>;
+};
+
+/**
+ * @brief Argument lists, whose arguments all have an interval form.
+ */
+template<typename T>
+struct enumerable_args : std::false_type {};
+
+template<template<typename...> typename C, typename... Args>
+struct enumerable_args<C<Args...>> : std::bool_constant<(has_intervals<std::remove_cvref_t<Args>> && ...)> {};
+
+}
+
+/**
+ * @brief Domain space of a tuple-like list of argument types, e.g. std::tuple<Args...>.
+ */
+template<typename ArgList>
+using domain_space_of = typename detail::domain_space_of<ArgList>::type;
+
+}
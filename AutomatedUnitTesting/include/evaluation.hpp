@@ -4,97 +4,141 @@
 #include "constraint_combiner.hpp"
 #include <array>
 #include <algorithm>
+#include <limits>
 
 namespace aut {
 
-template<auto values>
-constexpr auto remove_duplicates() {
-    constexpr auto new_sz = [] {
-        size_t sz = 0;
-        for (size_t i = 0; i < std::size(values); i++)
-        {
-            bool duplicate = false;
-            for (size_t j = 0; j < i; j++)
-            {
-                if (values[i] == values[j]) {
-                    duplicate = true;
-                    break;
-                }
-            }
-            if (!duplicate) sz++;
+template<typename T>
+struct evaluate;
+
+namespace detail {
+
+/**
+ * @brief Sorted set of unique values with a fixed capacity.
+ *
+ * Used to compute the border values of combined constraints at compile time. The capacity is an upper bound, the
+ * actual size is only known after the set has been computed. Each set is computed once and then shrunk to a
+ * std::array of the actual size with shrink().
+ *
+ * @tparam T Value type.
+ * @tparam N Capacity.
+ */
+template<typename T, size_t N>
+struct value_set {
+    std::array<T, N> values{};
+    size_t size = 0;
+
+    /**
+     * @brief Appends a value, which must not be smaller than the last one. Duplicates are skipped.
+     */
+    constexpr void push_back(const T& v) {
+        if (size == 0 || values[size - 1] != v) values[size++] = v;
+    }
+};
+
+/**
+ * @brief Sorts the values and removes duplicates in O(n log n).
+ */
+template<typename T, size_t N>
+constexpr value_set<T, N> make_value_set(std::array<T, N> values) {
+    std::sort(values.begin(), values.end());
+    value_set<T, N> set;
+    for (const auto& v : values) set.push_back(v);
+    return set;
+}
+
+/**
+ * @brief Merges two sorted sets in O(n).
+ *
+ * Values which are contained in both sets are always kept. Values which are only contained in one set are kept
+ * if the corresponding predicate returns true.
+ */
+template<typename T, size_t Na, size_t Nb, typename KeepA, typename KeepB>
+constexpr value_set<T, Na + Nb> merge(const value_set<T, Na>& a, const value_set<T, Nb>& b, KeepA keep_a, KeepB keep_b) {
+    value_set<T, Na + Nb> merged;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size && j < b.size) {
+        if (a.values[i] < b.values[j]) {
+            if (keep_a(a.values[i])) merged.push_back(a.values[i]);
+            i++;
+        }
+        else if (b.values[j] < a.values[i]) {
+            if (keep_b(b.values[j])) merged.push_back(b.values[j]);
+            j++;
         }
-        return sz;
-    }();
-
-    std::array<typename decltype(values)::value_type, new_sz> unified{};
-    size_t curr_sz = 0;
-    for (const auto v : values) {
-        bool duplicate = false;
-        for (size_t i = 0; i < curr_sz; i++) {
-            if (unified[i] == v) {
-                duplicate = true;
-                break;
-            }
+        else {
+            merged.push_back(a.values[i]);
+            i++;
+            j++;
         }
-        if (!duplicate) unified[curr_sz++] = v;
     }
-    return unified;
+    for (; i < a.size; i++) {
+        if (keep_a(a.values[i])) merged.push_back(a.values[i]);
+    }
+    for (; j < b.size; j++) {
+        if (keep_b(b.values[j])) merged.push_back(b.values[j]);
+    }
+    return merged;
+}
+
+/**
+ * @brief Border values of an interval set, i.e. the bounds of all intervals, except for the ends of the domain.
+ *
+ * A set which covers the whole domain has no border, so 0 is used as its single value. A set which only
+ * contains NaN has NaN as its single value.
+ */
+template<typename T, size_t N>
+constexpr value_set<T, 2 * N + 1> interval_border_values(const interval_set<T, N>& set) {
+    value_set<T, 2 * N + 1> values;
+    for (size_t i = 0; i < set.size; i++) {
+        const auto& iv = set.intervals[i];
+        if (iv.lo != domain_min<T>()) values.push_back(iv.lo);
+        if (iv.hi != domain_max<T>()) values.push_back(iv.hi);
+    }
+    if (values.size == 0 && set.size > 0) values.push_back(T{});
+    if (values.size == 0 && set.nan) values.push_back(std::numeric_limits<T>::quiet_NaN());
+    return values;
 }
 
+/**
+ * @brief Copies the values of a set into an array of the actual size.
+ * @tparam N Size of the set.
+ */
+template<size_t N, typename T, size_t Capacity>
+constexpr std::array<T, N> shrink(const value_set<T, Capacity>& set) {
+    std::array<T, N> values{};
+    std::copy(set.values.begin(), set.values.begin() + N, values.begin());
+    return values;
+}
+
+}
+
+/**
+ * @brief Sorted union of the border values of two constraints.
+ */
 template<typename A, typename B> requires is_constrained<A>&& is_constrained<B>
 constexpr auto border_value_union() {
-    constexpr auto values_a = evaluate<A>::valid_border_values;
-    constexpr auto values_b = evaluate<B>::valid_border_values;
-
-    std::array<typename A::value_type, std::size(values_a)+std::size(values_b)> merged_values{};
-    size_t sz = 0;
-    for (const auto va : values_a) {
-        merged_values[sz] = va;
-        sz++;
-    }
-    for (const auto vb : values_b) {
-        merged_values[sz] = vb;
-        sz++;
-    }
-    return merged_values;
+    using T = typename A::value_type;
+    constexpr auto keep = [](const T&) { return true; };
+    return detail::merge(detail::make_value_set(evaluate<A>::valid_border_values),
+                         detail::make_value_set(evaluate<B>::valid_border_values), keep, keep);
 }
 
+/**
+ * @brief Sorted border values of two constraints, which are valid for both constraints.
+ *
+ * The border values of a constraint are valid for the constraint itself, so each value only needs to be checked
+ * against the other constraint.
+ */
 template<typename A, typename B> requires is_constrained<A>&& is_constrained<B>
-    constexpr auto border_value_intersect() {
-        constexpr auto values_a = evaluate<A>::valid_border_values;
-        constexpr auto values_b = evaluate<B>::valid_border_values;
-
-        constexpr auto cnt = [values_a, values_b]() constexpr {
-            size_t sz = 0;
-            for (const auto va : values_a) {
-                if (!A{ va }.is_valid()) continue;
-                if (!B{ va }.is_valid()) continue;
-                sz++;
-            }
-            for (const auto vb : values_b) {
-                if (!A{ vb }.is_valid()) continue;
-                if (!B{ vb }.is_valid()) continue;
-                sz++;
-            }
-            return sz;
-        } ();
-
-        std::array<typename A::value_type, cnt> merged_values{};
-        size_t sz = 0;
-        for (const auto va : values_a) {
-            if (!A{ va }.is_valid()) continue;
-            if (!B{ va }.is_valid()) continue;
-            merged_values[sz] = va;
-            sz++;
-        }
-        for (const auto vb : values_b) {
-            if (!A{ vb }.is_valid()) continue;
-            if (!B{ vb }.is_valid()) continue;
-            merged_values[sz] = vb;
-            sz++;
-        }
-        return merged_values;
-    }
+constexpr auto border_value_intersect() {
+    using T = typename A::value_type;
+    return detail::merge(detail::make_value_set(evaluate<A>::valid_border_values),
+                         detail::make_value_set(evaluate<B>::valid_border_values),
+                         [](const T& v) { return B{ unchecked, v }.is_valid(); },
+                         [](const T& v) { return A{ unchecked, v }.is_valid(); });
+}
 
 
 template<typename T>
@@ -141,13 +185,26 @@ struct evaluate<one_of<Option0, Options...>> {
 template<typename A, typename B>
 struct evaluate<_and<A, B>> {
     using value_type = typename A::value_type;
-    static constexpr auto valid_border_values = remove_duplicates<border_value_intersect<A, B>()>();
+    static constexpr auto border_set = border_value_intersect<A, B>();
+    static constexpr auto valid_border_values = detail::shrink<border_set.size>(border_set);
 };
 
 template<typename A, typename B>
 struct evaluate<_or<A, B>> {
     using value_type = typename A::value_type;
-    static constexpr auto valid_border_values = remove_duplicates<border_value_union<A, B>()>();
+    static constexpr auto border_set = border_value_union<A, B>();
+    static constexpr auto valid_border_values = detail::shrink<border_set.size>(border_set);
+};
+
+/**
+ * @brief The border values of a negation are derived from the complement of the interval form of the constraint.
+ */
+template<typename A>
+struct evaluate<_not<A>> {
+    static_assert(has_intervals<_not<A>>, "Negated constraints need an interval form, see intervals_of.");
+    using value_type = typename A::value_type;
+    static constexpr auto border_set = detail::interval_border_values(intervals_of<_not<A>>::value);
+    static constexpr auto valid_border_values = detail::shrink<border_set.size>(border_set);
 };
 
 }
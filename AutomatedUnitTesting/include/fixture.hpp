@@ -0,0 +1,150 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "containers.hpp"
+#include "parallel.hpp"
+
+namespace aut {
+
+namespace detail {
+
+/**
+ * @brief Default reset of fixture, see fixture_pool.
+ */
+struct default_reset {};
+
+}
+
+/**
+ * @brief Creates and resets the objects, on which member functions are tested.
+ *
+ * The factory is called once per worker thread. Before each further case, the worker's object is reset instead of
+ * constructed again, so expensive constructors do not dominate the run time. Without a reset callable, objects are reset
+ * with their reset() member function if they have one, or by copy-assigning a prototype, which is created once with the
+ * factory. Objects of const member functions are never reset, not even with a reset callable.
+ *
+ * @tparam Factory Callable without arguments, which returns a new object.
+ * @tparam Reset Callable, which takes a reference to a used object and restores the state of a new one.
+ */
+template<typename Factory, typename Reset = detail::default_reset>
+struct fixture {
+    Factory factory;
+    Reset reset;
+
+    constexpr fixture(Factory factory, Reset reset = {}) : factory(std::move(factory)), reset(std::move(reset)) {}
+};
+
+namespace detail {
+
+template<typename T>
+struct is_fixture : std::false_type {};
+
+template<typename Factory, typename Reset>
+struct is_fixture<fixture<Factory, Reset>> : std::true_type {};
+
+/**
+ * @brief Wraps a bare factory into a fixture with the default reset.
+ */
+template<typename T>
+constexpr auto make_fixture(T&& t) {
+    if constexpr (is_fixture<std::remove_cvref_t<T>>::value) return std::forward<T>(t);
+    else return fixture<std::remove_cvref_t<T>>{ std::forward<T>(t) };
+}
+
+/**
+ * @brief One object per worker thread, which is created on first use and reset before each further case.
+ * @tparam Class Class of the tested member function.
+ * @tparam Fixture Instance of the fixture template.
+ * @tparam ConstMember True if the tested member function is const, i.e. cannot change the object.
+ */
+template<typename Class, typename Fixture, bool ConstMember>
+class fixture_pool {
+    static constexpr bool custom_reset = !std::same_as<decltype(std::declval<Fixture>().reset), default_reset>;
+    static constexpr bool member_reset = requires(Class& c) { c.reset(); };
+    static constexpr bool prototype_reset = !ConstMember && !custom_reset && !member_reset;
+
+    static_assert(!prototype_reset || std::is_copy_assignable_v<Class>,
+        "The fixture class needs a reset() member function, a reset callable or a copy assignment operator!");
+
+    /**
+     * @brief Each worker's object lives on its own cache lines.
+     */
+    struct alignas(64) slot {
+        std::optional<Class> object;
+        size_t constructions = 0;
+    };
+
+public:
+    fixture_pool(Fixture fixture, size_t threads) : m_fixture(std::move(fixture)), m_slots(resolve_thread_count(threads)) {
+        if constexpr (prototype_reset) m_prototype.emplace(m_fixture.factory());
+    }
+
+    /**
+     * @brief Returns the object of a worker in the state of a new object.
+     * @param worker Index of the worker, see parallel_for.
+     */
+    Class& acquire(size_t worker) {
+        slot& s = m_slots[worker];
+        if (!s.object) {
+            s.object.emplace(m_fixture.factory());
+            s.constructions++;
+        }
+        else if constexpr (ConstMember) {}
+        else if constexpr (custom_reset) m_fixture.reset(*s.object);
+        else if constexpr (member_reset) s.object->reset();
+        else *s.object = *m_prototype;
+        return *s.object;
+    }
+
+    /**
+     * @brief Number of objects created with the factory, without the prototype.
+     */
+    size_t constructions() const {
+        size_t n = 0;
+        for (const auto& s : m_slots) n += s.constructions;
+        return n;
+    }
+
+private:
+    Fixture m_fixture;
+    std::vector<slot> m_slots;
+    std::optional<Class> m_prototype;
+};
+
+/**
+ * @brief Member function together with the pool of objects to call it on. Passed to the test runners in place of a
+ *        function.
+ */
+template<typename MemberFunc, typename Class, typename Fixture, bool ConstMember>
+struct member_case {
+    MemberFunc func;
+    fixture_pool<Class, Fixture, ConstMember> pool;
+};
+
+/**
+ * @brief Calls the function under test with the arguments of a case. Container arguments are built first, see
+ *        apply_case.
+ * @param worker Index of the calling worker, see parallel_for.
+ */
+template<typename Func, typename Tuple>
+decltype(auto) invoke_case(Func& func, size_t, const Tuple& args) {
+    return apply_case(func, args);
+}
+
+template<typename MemberFunc, typename Class, typename Fixture, bool ConstMember, typename Tuple>
+decltype(auto) invoke_case(member_case<MemberFunc, Class, Fixture, ConstMember>& c, size_t worker, const Tuple& args) {
+    Class& object = c.pool.acquire(worker);
+    return apply_case([&](auto&&... a) { return std::invoke(c.func, object, a...); }, args);
+}
+
+}
+
+}
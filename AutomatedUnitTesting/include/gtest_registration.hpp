@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "testgenerator.hpp"
+
+namespace aut {
+
+namespace detail {
+
+/**
+ * @brief Test, whose body is set at runtime, see register_test_func.
+ */
+class generated_cases_test : public ::testing::Test {
+public:
+    explicit generated_cases_test(std::function<void()> body) : m_body(std::move(body)) {}
+
+    void TestBody() override { m_body(); }
+
+private:
+    std::function<void()> m_body;
+};
+
+/**
+ * @brief Name of the test of the cases [first, last], e.g. cases_0064_0127. The indices are padded to the width of the
+ *        largest index, so the names sort like the cases.
+ */
+inline std::string block_name(size_t first, size_t last, size_t total) {
+    const size_t width = std::to_string(total > 0 ? total - 1 : 0).size();
+    const auto pad = [width](size_t v) {
+        std::string s = std::to_string(v);
+        return std::string(width - std::min(width, s.size()), '0') + s;
+    };
+    return "cases_" + pad(first) + "_" + pad(last);
+}
+
+}
+
+/**
+ * @brief Registers the generated cases of a function as gtest tests, each of block_size consecutive cases.
+ *
+ * The blocks partition the flat positions of the run, see test_options::first_case, and are named after their first
+ * and last position. Each test runs test_func on its block and fails with the report of the block, if a case failed.
+ * As separate tests, the blocks are listed by gtest_discover_tests, run in parallel by ctest -j and split across
+ * processes or machines by GTEST_TOTAL_SHARDS and GTEST_SHARD_INDEX without any coordination.
+ *
+ * Has to be called before RUN_ALL_TESTS(), e.g. in main() or in the initializer of a static variable:
+ * static const size_t registered = aut::register_test_func("Fib", fib, 16);
+ *
+ * @param suite Name of the test suite.
+ * @param func Function under test. Functors are copied, functions have to outlive the test run.
+ * @param block_size Number of cases per test. 1 registers every case as a test of its own.
+ * @param options Options of the runs. first_case and num_cases select the part of the run, which is registered.
+ *        The report is only printed for failed blocks.
+ * @return Returns the number of registered tests.
+ */
+template<typename Func>
+size_t register_test_func(const char* suite, Func& func, size_t block_size = 64, const test_options& options = {},
+                          const std::source_location location = std::source_location::current()) {
+    using func_def = detail::parse_signature<Func>;
+    using space = case_space_of<typename func_def::arg_types>;
+    using holder_type = std::conditional_t<std::is_function_v<Func>, Func*, Func>;
+
+    size_t total = space::size;
+    if (options.coverage != coverage::exhaustive) {
+        total = covering_array(std::vector<size_t>(space::radices.begin(), space::radices.end()),
+                               static_cast<size_t>(options.coverage)).size();
+    }
+    const size_t first = std::min(options.first_case, total);
+    const size_t end = first + std::min(options.num_cases, total - first);
+    block_size = std::max<size_t>(block_size, 1);
+
+    std::shared_ptr<holder_type> holder;
+    if constexpr (std::is_function_v<Func>) holder = std::make_shared<holder_type>(&func);
+    else holder = std::make_shared<holder_type>(func);
+
+    size_t registered = 0;
+    for (size_t begin = first; begin < end; begin += block_size) {
+        test_options block = options;
+        block.first_case = begin;
+        block.num_cases = std::min(block_size, end - begin);
+        block.print = false;
+
+        const std::string name = detail::block_name(begin, begin + block.num_cases - 1, total);
+        ::testing::RegisterTest(suite, name.c_str(), nullptr, nullptr, location.file_name(), static_cast<int>(location.line()),
+            [holder, block]() -> ::testing::Test* {
+                return new detail::generated_cases_test([holder, block] {
+                    auto& f = [&]() -> Func& {
+                        if constexpr (std::is_function_v<Func>) return **holder;
+                        else return *holder;
+                    }();
+                    const auto report = test_func{ f, block }.report;
+                    EXPECT_TRUE(report.passed()) << report;
+                });
+            });
+        registered++;
+    }
+    return registered;
+}
+
+}
@@ -3,36 +3,46 @@
 #include<cmath>
 #include <chrono>
 #include <algorithm>
+#include <iostream>
 #include <numeric>
 
+#include "benchmark.hpp"
+
 namespace aut {
+/**
+ * @brief True if two floating point values differ by less than the tolerance. Equal infinities are equal as well.
+ */
+template<typename T>
+constexpr inline bool float_equal(const T& t1, const T& t2, T tolerance) {
+    return t1 == t2 || std::abs(t1 - t2) < tolerance;
+}
+
 template<typename T, T tolerance = 1e-4>
 constexpr inline bool float_equal(const T& t1, const T& t2) {
-    return std::abs(t1 - t2) < tolerance;
+    return float_equal(t1, t2, tolerance);
 }
 
 
 using Duration = std::chrono::duration<double, std::milli>;
+
+/**
+ * @brief Measures and prints the runtime of single calls of a function.
+ *
+ * Thin wrapper around run_benchmark() without calibration, i.e. each of the samples times exactly one call.
+ * Use run_benchmark() directly for short functions, percentiles, confidence intervals and JSON output.
+ */
 template<typename Func, size_t iterations = 10000>
 void measure_runtime(Func&& func) {
-    std::array< Duration, iterations> durations;
-    for (size_t i = 0; i < iterations; i++)
-    {
-        auto t1 = std::chrono::high_resolution_clock::now();
-        func();
-        auto t2 = std::chrono::high_resolution_clock::now();
-
-        durations[i] = t2 - t1;
-    }
-    const Duration avgDuration = std::accumulate(durations.begin(), durations.end(), Duration{ 0 }) / iterations;
-    const auto minmax = std::minmax_element(durations.begin(), durations.end());
-    const Duration minDuration = *minmax.first;
-    const Duration maxDuration = *minmax.second;
+    benchmark_options options;
+    options.samples = iterations;
+    options.min_sample_time = std::chrono::nanoseconds{ 0 };
 
+    const benchmark_result r = run_benchmark("measure_runtime", func, options);
     std::cout << "Measured runtime over " << iterations << " iterations:" << std::endl;
-    std::cout << "Average: " << avgDuration.count() << " ms" << std::endl;
-    std::cout << "Minimum: " << minDuration.count() << " ms" << std::endl;
-    std::cout << "Maximum: " << maxDuration.count() << " ms" << std::endl;
+    std::cout << "Average: " << Duration{ std::chrono::duration<double, std::nano>{ r.mean } }.count() << " ms" << std::endl;
+    std::cout << "Minimum: " << Duration{ std::chrono::duration<double, std::nano>{ r.min } }.count() << " ms" << std::endl;
+    std::cout << "Maximum: " << Duration{ std::chrono::duration<double, std::nano>{ r.max } }.count() << " ms" << std::endl;
+    std::cout << "p50/p90/p99: " << r.p50 << " / " << r.p90 << " / " << r.p99 << " ns" << std::endl;
 }
 
 
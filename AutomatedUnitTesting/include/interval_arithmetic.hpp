@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include "constraint_proxy.hpp"
+#include "constraints.hpp"
+#include "interval_set.hpp"
+
+namespace aut {
+
+// Interval arithmetic for all constraints, e.g. by setting the AUT_INTERVAL_ARITHMETIC CMake option. It has to be the
+// same in all translation units of a program.
+#ifndef AUT_INTERVAL_ARITHMETIC
+#define AUT_INTERVAL_ARITHMETIC 0
+#endif
+
+/**
+ * @brief Whether +, -, * and / on a constraint type derive the interval of their result at compile time, see bounded.
+ *        Specialize it to enable the interval arithmetic for single types, independent of AUT_INTERVAL_ARITHMETIC.
+ * @tparam C Constraint type.
+ */
+template<typename C>
+struct interval_arithmetic_of : std::bool_constant<AUT_INTERVAL_ARITHMETIC != 0> {};
+
+namespace detail {
+
+template<template<typename> class OP, typename T2, typename U2>
+constexpr auto derived_op(const T2& lhs, const U2& rhs) noexcept;
+
+}
+
+/**
+ * @brief Result of an arithmetic operation on constrained values, whose interval [LO, HI] was derived at compile time
+ *        from the intervals of the operands.
+ *
+ * Behaves like in_range<LO, HI, T>, and further operations on it derive their intervals as well. Constructing a
+ * constraint from it skips the check, if [LO, HI] lies inside that constraint. Only the derived operators create
+ * bounded values, it only converts to bounded types with a wider interval, and it cannot be incremented or assigned
+ * to with compound operators. So as long as all constrained operands hold valid values, a function returning a bounded
+ * value is valid for all valid arguments. With check_mode::none, constraints constructed from raw values are not
+ * checked, so test_func still executes such functions by default (see test_options::skip_proven).
+ *
+ * @tparam LO Smallest possible value.
+ * @tparam HI Largest possible value.
+ * @tparam T Value type.
+ */
+template<auto LO, auto HI, typename T>
+struct bounded : public in_range<LO, HI, T> {
+    template<auto LO2, auto HI2> requires (LO <= LO2 && HI2 <= HI)
+    constexpr bounded(const bounded<LO2, HI2, T>& b) noexcept : in_range<LO, HI, T>(unchecked, b.m_t) {}
+
+    bounded& operator++() = delete;
+    bounded operator++(int) = delete;
+    bounded& operator--() = delete;
+    bounded operator--(int) = delete;
+    template<typename U> bounded& operator+=(const U&) = delete;
+    template<typename U> bounded& operator-=(const U&) = delete;
+    template<typename U> bounded& operator*=(const U&) = delete;
+    template<typename U> bounded& operator/=(const U&) = delete;
+
+private:
+    constexpr bounded(unchecked_t, const T& t) noexcept : in_range<LO, HI, T>(unchecked, t) {}
+
+    template<template<typename> class OP, typename T2, typename U2>
+    friend constexpr auto detail::derived_op(const T2& lhs, const U2& rhs) noexcept;
+};
+
+template<auto LO, auto HI, typename T> requires detail::interval_type<T>
+struct intervals_of<bounded<LO, HI, T>> : intervals_of<in_range<LO, HI, T>> {};
+
+template<auto LO, auto HI, typename T>
+struct interval_arithmetic_of<bounded<LO, HI, T>> : std::true_type {};
+
+namespace detail {
+
+template<typename T>
+struct is_bounded : std::false_type {};
+
+/**
+ * @brief Bounded values cannot be made from raw values, so reports print them as in_range.
+ */
+template<typename R>
+struct output_printer;
+
+template<auto LO, auto HI, typename T>
+struct output_printer<bounded<LO, HI, T>> {
+    static in_range<LO, HI, T> make(const T& v) { return { unchecked, v }; }
+};
+
+template<auto LO, auto HI, typename T>
+struct is_bounded<bounded<LO, HI, T>> : std::true_type {};
+
+/**
+ * @brief Interval of an operation, which is not valid if it may overflow the value type, divide by zero or give NaN.
+ */
+template<typename T>
+struct derived_interval {
+    bool valid = false;
+    T lo{};
+    T hi{};
+};
+
+/**
+ * @brief Applies OP to two bounds, or returns false if the exact result does not fit into T.
+ *
+ * Floating point results may be infinite, but not NaN. Integer results are checked before they are computed, as the
+ * operators of the operands would overflow in the same way at runtime.
+ */
+template<template<typename> class OP, typename T>
+constexpr bool checked_op(T a, T b, T& result) {
+    if constexpr (std::floating_point<T>) {
+        if constexpr (std::is_same_v<OP<T>, std::divides<T>>) {
+            if (b == 0) return false;
+        }
+        result = OP<T>{}(a, b);
+        return result == result;
+    }
+    else {
+        constexpr T min = std::numeric_limits<T>::lowest();
+        constexpr T max = std::numeric_limits<T>::max();
+        // The operators of types smaller than int compute in int and convert the result back.
+        using op_type = std::common_type_t<T, int>;
+        bool fits = true;
+        if constexpr (std::is_same_v<OP<T>, std::plus<T>>) {
+            fits = b >= 0 ? a <= max - b : a >= min - b;
+        }
+        else if constexpr (std::is_same_v<OP<T>, std::minus<T>>) {
+            if constexpr (std::is_signed_v<T>) fits = b >= 0 ? a >= min + b : a <= max + b;
+            else fits = a >= b;
+        }
+        else if constexpr (std::is_same_v<OP<T>, std::multiplies<T>>) {
+            if (a != 0 && b != 0) {
+                if constexpr (std::is_signed_v<T>) {
+                    if (a > 0) fits = b > 0 ? a <= max / b : b >= min / a;
+                    else fits = b > 0 ? a >= min / b : a >= max / b;
+                }
+                else {
+                    fits = a <= max / b;
+                }
+            }
+        }
+        else {
+            static_assert(std::is_same_v<OP<T>, std::divides<T>>, "Unsupported operation!");
+            if constexpr (std::is_signed_v<T>) fits = b != 0 && !(a == min && b == -1);
+            else fits = b != 0;
+        }
+        if (!fits) return false;
+        result = static_cast<T>(OP<op_type>{}(static_cast<op_type>(a), static_cast<op_type>(b)));
+        return true;
+    }
+}
+
+/**
+ * @brief Interval of a OP b for all a in [a_lo, a_hi] and b in [b_lo, b_hi].
+ *
+ * +, -, * and / are monotonic in each operand, if the divisor does not change its sign, so the extremes are the
+ * results of the bounds. This also holds for rounded floating point and truncated integer results. An infinite bound
+ * times a 0 inside the other interval is NaN, which the bounds do not show.
+ */
+template<template<typename> class OP, typename T>
+constexpr derived_interval<T> derive(T a_lo, T a_hi, T b_lo, T b_hi) {
+    if constexpr (std::is_same_v<OP<T>, std::divides<T>>) {
+        if (b_lo <= 0 && b_hi >= 0) return {};
+    }
+    if constexpr (std::floating_point<T> && std::is_same_v<OP<T>, std::multiplies<T>>) {
+        constexpr T inf = std::numeric_limits<T>::infinity();
+        const bool a_inf = a_lo == -inf || a_hi == inf;
+        const bool b_inf = b_lo == -inf || b_hi == inf;
+        if ((a_inf && b_lo <= 0 && b_hi >= 0) || (b_inf && a_lo <= 0 && a_hi >= 0)) return {};
+    }
+    const T as[] = { a_lo, a_hi };
+    const T bs[] = { b_lo, b_hi };
+    derived_interval<T> r{ true, std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() };
+    for (const T a : as) {
+        for (const T b : bs) {
+            T v{};
+            if (!checked_op<OP>(a, b, v)) return {};
+            r.lo = std::min(r.lo, v);
+            r.hi = std::max(r.hi, v);
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Constraints, whose interval form is known and not empty and does not contain NaN.
+ */
+template<typename C>
+concept interval_operand = is_constrained<C> && has_intervals<C> &&
+    std::same_as<typename intervals_of<C>::value_type, typename C::value_type> &&
+    intervals_of<C>::value.size > 0 && !intervals_of<C>::value.nan;
+
+/**
+ * @brief Result interval of lhs OP rhs, see derive().
+ */
+template<template<typename> class OP, typename T2, typename U2>
+struct derived_operation {
+    static constexpr auto& lhs = intervals_of<T2>::value;
+    static constexpr auto& rhs = intervals_of<U2>::value;
+    static constexpr auto value = derive<OP>(lhs.intervals[0].lo, lhs.intervals[lhs.size - 1].hi,
+                                             rhs.intervals[0].lo, rhs.intervals[rhs.size - 1].hi);
+};
+
+/**
+ * @brief Operations, whose result interval is derived: both operands have an interval form and the same value type,
+ *        one of them enables the interval arithmetic, and the result can neither overflow nor be NaN.
+ */
+template<template<typename> class OP, typename T2, typename U2>
+concept derivable = interval_operand<T2> && interval_operand<U2> &&
+    std::same_as<typename T2::value_type, typename U2::value_type> &&
+    (interval_arithmetic_of<T2>::value || interval_arithmetic_of<U2>::value) &&
+    derived_operation<OP, T2, U2>::value.valid;
+
+template<template<typename> class OP, typename T2, typename U2>
+constexpr auto derived_op(const T2& lhs, const U2& rhs) noexcept {
+    using T = typename T2::value_type;
+    constexpr auto iv = derived_operation<OP, T2, U2>::value;
+    return bounded<iv.lo, iv.hi, T>{ unchecked, OP<T>{}(lhs.m_t, rhs.m_t) };
+}
+
+/**
+ * @brief True if [LO, HI] lies inside the interval form of C.
+ */
+template<auto LO, auto HI, typename C>
+constexpr bool proven_inside() {
+    if constexpr (has_intervals<C>) {
+        using T = typename intervals_of<C>::value_type;
+        if constexpr (std::same_as<decltype(LO), T>) {
+            constexpr auto& set = intervals_of<C>::value;
+            for (size_t i = 0; i < set.size; i++) {
+                if (set.intervals[i].lo <= LO && HI <= set.intervals[i].hi) return true;
+            }
+        }
+    }
+    return false;
+}
+
+template<auto LO, auto HI, typename C>
+constexpr void check_derived(const C& c) noexcept(nothrow_checks<C>) {
+    if constexpr (!proven_inside<LO, HI, C>()) check_construction(c);
+}
+
+}
+
+template<typename T2, typename U2> requires at_least_one_constrained<T2, U2> && detail::derivable<std::plus, T2, U2>
+constexpr inline auto operator+(const T2& lhs, const U2& rhs) {
+    return detail::derived_op<std::plus>(lhs, rhs);
+}
+
+template<typename T2, typename U2> requires at_least_one_constrained<T2, U2> && detail::derivable<std::minus, T2, U2>
+constexpr inline auto operator-(const T2& lhs, const U2& rhs) {
+    return detail::derived_op<std::minus>(lhs, rhs);
+}
+
+template<typename T2, typename U2> requires at_least_one_constrained<T2, U2> && detail::derivable<std::multiplies, T2, U2>
+constexpr inline auto operator*(const T2& lhs, const U2& rhs) {
+    return detail::derived_op<std::multiplies>(lhs, rhs);
+}
+
+template<typename T2, typename U2> requires at_least_one_constrained<T2, U2> && detail::derivable<std::divides, T2, U2>
+constexpr inline auto operator/(const T2& lhs, const U2& rhs) {
+    return detail::derived_op<std::divides>(lhs, rhs);
+}
+
+}
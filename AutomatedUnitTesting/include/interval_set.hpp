@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "constraints.hpp"
+
+namespace aut {
+
+/**
+ * @brief Closed interval [lo, hi]. Discrete points are stored as intervals with lo == hi.
+ */
+template<typename T>
+struct interval {
+    T lo;
+    T hi;
+};
+
+/**
+ * @brief Sorted set of disjoint, non-adjacent closed intervals with a fixed capacity.
+ *
+ * The canonical form of a constraint: every constraint tree, which only consists of the constraints in
+ * constraints.hpp and the combiners, accepts exactly the values in one such set. NaN is not ordered and
+ * therefore tracked by a separate flag.
+ *
+ * @tparam T Value type.
+ * @tparam N Capacity.
+ */
+template<typename T, size_t N>
+struct interval_set {
+    std::array<interval<T>, N> intervals{};
+    size_t size = 0;
+    bool nan = false;
+
+    /**
+     * @brief Appends an interval, whose lower bound must not be smaller than the one of the last interval.
+     *        Overlapping and adjacent intervals are merged.
+     */
+    constexpr void push_back(const interval<T>& iv);
+};
+
+namespace detail {
+
+/**
+ * @brief Value types with an interval form. Floating point types need an integer type of the same size to step
+ *        between neighbouring values.
+ */
+template<typename T>
+concept interval_type = std::integral<T> ||
+    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
+/**
+ * @brief Smallest value of the domain, i.e. -inf for floating point types.
+ */
+template<typename T>
+constexpr T domain_min() {
+    if constexpr (std::floating_point<T>) return -std::numeric_limits<T>::infinity();
+    else return std::numeric_limits<T>::lowest();
+}
+
+/**
+ * @brief Largest value of the domain, i.e. +inf for floating point types.
+ */
+template<typename T>
+constexpr T domain_max() {
+    if constexpr (std::floating_point<T>) return std::numeric_limits<T>::infinity();
+    else return std::numeric_limits<T>::max();
+}
+
+/**
+ * @brief Smallest value, which is greater than v. v must be smaller than domain_max().
+ *
+ * The constexpr counterpart of std::nextafter(v, +inf). -0.0 and +0.0 are the same value.
+ */
+template<typename T>
+constexpr T next_up(T v) {
+    if constexpr (std::floating_point<T>) {
+        using bits_type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        if (v == 0) return std::numeric_limits<T>::denorm_min();
+        const auto bits = std::bit_cast<bits_type>(v);
+        return std::bit_cast<T>(v > 0 ? bits + 1 : bits - 1);
+    }
+    else {
+        return static_cast<T>(v + 1);
+    }
+}
+
+/**
+ * @brief Largest value, which is smaller than v. v must be greater than domain_min().
+ */
+template<typename T>
+constexpr T next_down(T v) {
+    if constexpr (std::floating_point<T>) {
+        return -next_up(-v);
+    }
+    else {
+        return static_cast<T>(v - 1);
+    }
+}
+
+template<typename T, size_t N>
+constexpr interval_set<T, N> make_interval_set(std::array<interval<T>, N> intervals, size_t size, bool nan = false) {
+    std::sort(intervals.begin(), intervals.begin() + size, [](const interval<T>& a, const interval<T>& b) { return a.lo < b.lo; });
+    interval_set<T, N> set;
+    for (size_t i = 0; i < size; i++) set.push_back(intervals[i]);
+    set.nan = nan;
+    return set;
+}
+
+/**
+ * @brief Set with a single interval, which is empty if lo > hi or one of the bounds is NaN.
+ */
+template<typename T>
+constexpr interval_set<T, 1> single(T lo, T hi) {
+    return make_interval_set<T, 1>({ interval<T>{ lo, hi } }, lo <= hi ? 1 : 0);
+}
+
+/**
+ * @brief Set of discrete points in O(n log n). Consecutive integers are merged into a single interval, NaN points are dropped.
+ */
+template<typename T, size_t N>
+constexpr interval_set<T, N> points(const std::array<T, N>& values) {
+    std::array<interval<T>, N> intervals{};
+    size_t size = 0;
+    for (const auto& v : values) {
+        if (v == v) intervals[size++] = { v, v };
+    }
+    return make_interval_set(intervals, size);
+}
+
+/**
+ * @brief Union of two sets in O(n).
+ */
+template<typename T, size_t Na, size_t Nb>
+constexpr interval_set<T, Na + Nb> unite(const interval_set<T, Na>& a, const interval_set<T, Nb>& b) {
+    interval_set<T, Na + Nb> set;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size || j < b.size) {
+        if (j == b.size || (i < a.size && a.intervals[i].lo < b.intervals[j].lo)) set.push_back(a.intervals[i++]);
+        else set.push_back(b.intervals[j++]);
+    }
+    set.nan = a.nan || b.nan;
+    return set;
+}
+
+/**
+ * @brief Intersection of two sets in O(n).
+ */
+template<typename T, size_t Na, size_t Nb>
+constexpr interval_set<T, Na + Nb> intersect(const interval_set<T, Na>& a, const interval_set<T, Nb>& b) {
+    interval_set<T, Na + Nb> set;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size && j < b.size) {
+        const T lo = std::max(a.intervals[i].lo, b.intervals[j].lo);
+        const T hi = std::min(a.intervals[i].hi, b.intervals[j].hi);
+        if (lo <= hi) set.push_back({ lo, hi });
+        if (a.intervals[i].hi < b.intervals[j].hi) i++;
+        else j++;
+    }
+    set.nan = a.nan && b.nan;
+    return set;
+}
+
+/**
+ * @brief Complement of a set in [domain_min(), domain_max()] in O(n). The NaN flag is inverted for floating point types.
+ */
+template<typename T, size_t N>
+constexpr interval_set<T, N + 1> complement(const interval_set<T, N>& a) {
+    interval_set<T, N + 1> set;
+    T lo = domain_min<T>();
+    bool open = true;
+    for (size_t i = 0; i < a.size; i++) {
+        const auto& iv = a.intervals[i];
+        if (open && lo < iv.lo) set.push_back({ lo, next_down(iv.lo) });
+        open = iv.hi < domain_max<T>();
+        if (open) lo = next_up(iv.hi);
+    }
+    if (open) set.push_back({ lo, domain_max<T>() });
+    set.nan = std::floating_point<T> && !a.nan;
+    return set;
+}
+
+/**
+ * @brief Copies a set into a set with the capacity of its actual size.
+ * @tparam N Size of the set.
+ */
+template<size_t N, typename T, size_t Capacity>
+constexpr interval_set<T, N> shrink(const interval_set<T, Capacity>& set) {
+    interval_set<T, N> shrunk;
+    std::copy(set.intervals.begin(), set.intervals.begin() + N, shrunk.intervals.begin());
+    shrunk.size = N;
+    shrunk.nan = set.nan;
+    return shrunk;
+}
+
+}
+
+template<typename T, size_t N>
+constexpr void interval_set<T, N>::push_back(const interval<T>& iv) {
+    if (size > 0) {
+        auto& last = intervals[size - 1];
+        if (last.hi == detail::domain_max<T>() || detail::next_up(last.hi) >= iv.lo) {
+            last.hi = std::max(last.hi, iv.hi);
+            return;
+        }
+    }
+    intervals[size++] = iv;
+}
+
+/**
+ * @brief Interval form of a constraint.
+ *
+ * Specializations provide the value type and the interval set in "value", shrunk to its actual size.
+ * Constraints without a specialization, e.g. user-defined ones, are checked with their own is_valid().
+ */
+template<typename C>
+struct intervals_of;
+
+/**
+ * @brief Constraints with an interval form.
+ */
+template<typename C>
+concept has_intervals = requires { intervals_of<std::remove_cvref_t<C>>::value; };
+
+template<auto THRESHOLD, detail::interval_type T>
+struct intervals_of<less<THRESHOLD, T>> {
+    using value_type = T;
+    static constexpr auto value = THRESHOLD > detail::domain_min<T>() ?
+        detail::single(detail::domain_min<T>(), detail::next_down(THRESHOLD)) : interval_set<T, 1>{};
+};
+
+template<auto THRESHOLD, detail::interval_type T>
+struct intervals_of<greater<THRESHOLD, T>> {
+    using value_type = T;
+    static constexpr auto value = THRESHOLD < detail::domain_max<T>() ?
+        detail::single(detail::next_up(THRESHOLD), detail::domain_max<T>()) : interval_set<T, 1>{};
+};
+
+template<auto THRESHOLD, detail::interval_type T>
+struct intervals_of<less_eq<THRESHOLD, T>> {
+    using value_type = T;
+    static constexpr auto value = detail::single(detail::domain_min<T>(), THRESHOLD);
+};
+
+template<auto THRESHOLD, detail::interval_type T>
+struct intervals_of<greater_eq<THRESHOLD, T>> {
+    using value_type = T;
+    static constexpr auto value = detail::single(THRESHOLD, detail::domain_max<T>());
+};
+
+template<auto MIN, auto MAX, detail::interval_type T>
+struct intervals_of<in_range<MIN, MAX, T>> {
+    using value_type = T;
+    static constexpr auto value = detail::single(MIN, MAX);
+};
+
+template<auto Option0, auto ... Options> requires detail::interval_type<decltype(Option0)>
+struct intervals_of<one_of<Option0, Options...>> {
+    using value_type = decltype(Option0);
+    static constexpr auto set = detail::points(std::array<value_type, 1 + sizeof...(Options)>{ Option0, static_cast<value_type>(Options)... });
+    static constexpr auto value = detail::shrink<set.size>(set);
+};
+
+namespace detail {
+
+/**
+ * @brief Membership test for the interval form of a constraint.
+ *
+ * Up to max_fold_size intervals are tested with a chain of comparisons, in which bounds at the ends of the domain
+ * are omitted and points are tested for equality. Larger sets use a binary search over the intervals.
+ *
+ * @tparam C Constraint with an interval form.
+ */
+template<typename C> requires has_intervals<C>
+struct interval_check {
+    using T = typename intervals_of<C>::value_type;
+    static constexpr const auto& set = intervals_of<C>::value;
+
+    static constexpr size_t max_fold_size = 8;
+
+    static constexpr bool contains(T v) {
+        if constexpr (set.nan) {
+            return v != v || contains_ordered(v);
+        }
+        else {
+            return contains_ordered(v);
+        }
+    }
+
+private:
+    static constexpr bool contains_ordered(T v) {
+        if constexpr (set.size == 0) {
+            return false;
+        }
+        else if constexpr (set.size <= max_fold_size) {
+            return contains_fold(v, std::make_index_sequence<set.size>{});
+        }
+        else {
+            const auto end = set.intervals.begin() + set.size;
+            const auto it = std::lower_bound(set.intervals.begin(), end, v, [](const interval<T>& iv, T x) { return iv.hi < x; });
+            return it != end && it->lo <= v;
+        }
+    }
+
+    template<size_t... Is>
+    static constexpr bool contains_fold(T v, std::index_sequence<Is...>) {
+        return (in<Is>(v) || ...);
+    }
+
+    template<size_t I>
+    static constexpr bool in(T v) {
+        constexpr interval<T> iv = set.intervals[I];
+        constexpr bool open_below = iv.lo == domain_min<T>();
+        constexpr bool open_above = iv.hi == domain_max<T>();
+        if constexpr (open_below && open_above) return v == v;
+        else if constexpr (open_below) return v <= iv.hi;
+        else if constexpr (open_above) return v >= iv.lo;
+        else if constexpr (iv.lo == iv.hi) return v == iv.lo;
+        else return v >= iv.lo && v <= iv.hi;
+    }
+};
+
+}
+
+}
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "parallel.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AUT_HAS_FORK 1
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace aut {
+
+/**
+ * @brief Why a case of an isolated run failed without returning a value.
+ */
+enum class case_fault : uint8_t {
+    none,
+    /**
+     * @brief The worker process was terminated by a signal, e.g. SIGSEGV.
+     */
+    crash,
+    /**
+     * @brief The case exceeded test_options::case_timeout and the worker process was killed.
+     */
+    timeout,
+    /**
+     * @brief The function under test threw an exception, which ended the worker process.
+     */
+    exception
+};
+
+#ifdef AUT_HAS_FORK
+
+namespace detail {
+
+/**
+ * @brief Array in anonymous shared memory, which stays shared with the processes forked after its creation.
+ * @tparam T Element type without pointers into process memory, e.g. numbers or lock-free atomics.
+ */
+template<typename T>
+class shared_array {
+    static_assert(std::is_trivially_destructible_v<T>, "Shared memory can only hold trivially destructible types!");
+
+public:
+    explicit shared_array(size_t size) : m_size(size) {
+        void* p = mmap(nullptr, bytes(), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::runtime_error{ "mmap of " + std::to_string(bytes()) + " bytes failed" };
+        m_data = static_cast<T*>(p);
+        std::uninitialized_value_construct_n(m_data, m_size);
+    }
+
+    ~shared_array() { munmap(m_data, bytes()); }
+
+    shared_array(const shared_array&) = delete;
+    shared_array& operator=(const shared_array&) = delete;
+
+    T& operator[](size_t i) { return m_data[i]; }
+    const T& operator[](size_t i) const { return m_data[i]; }
+    size_t size() const { return m_size; }
+
+private:
+    size_t bytes() const { return std::max<size_t>(m_size * sizeof(T), 1); }
+
+    T* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief Progress of a worker process, written by the worker and read by the watchdog. Both fields are lock-free
+ *        atomics, which also work between processes.
+ */
+struct alignas(64) worker_progress {
+    static constexpr size_t idle = static_cast<size_t>(-1);
+
+    /**
+     * @brief Position of the running case, or idle.
+     */
+    std::atomic<size_t> current{ idle };
+
+    /**
+     * @brief Start of the running case on the steady clock in ns. Written before current.
+     */
+    std::atomic<int64_t> started{ 0 };
+
+    static_assert(std::atomic<size_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free);
+};
+
+inline int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Half-open range of case positions, which is sent to a worker process.
+ */
+struct case_batch {
+    size_t begin;
+    size_t end;
+};
+
+/**
+ * @brief Forked worker process, which receives batches over one pipe and confirms each finished batch over another.
+ */
+class worker_process {
+public:
+    /**
+     * @brief Exit code of a child, which was left by an exception.
+     */
+    static constexpr int exception_exit_code = 70;
+
+    /**
+     * @brief Forks the process. The child calls run(tasks_fd, done_fd) and exits without running any destructors or
+     *        atexit handlers of the parent. An exception must not unwind into the stack of the parent, so it ends the
+     *        child with exception_exit_code.
+     * @param inherited Descriptors of the coordinator, which the child closes. A child must not keep the task pipe of
+     *        another worker open, otherwise that worker never sees the end of its tasks.
+     */
+    void spawn(const std::vector<int>& inherited, function_ref<void(int, int)> run) {
+        int tasks[2];
+        int done[2];
+        if (pipe(tasks) != 0) throw std::runtime_error{ "pipe failed" };
+        if (pipe(done) != 0) {
+            close(tasks[0]);
+            close(tasks[1]);
+            throw std::runtime_error{ "pipe failed" };
+        }
+
+        // Buffered output would otherwise be written again by the child.
+        std::fflush(nullptr);
+        m_pid = fork();
+        if (m_pid < 0) throw std::runtime_error{ "fork failed" };
+        if (m_pid == 0) {
+            for (const int fd : inherited) close(fd);
+            close(tasks[1]);
+            close(done[0]);
+            try {
+                run(tasks[0], done[1]);
+            }
+            catch (...) {
+                _exit(exception_exit_code);
+            }
+            _exit(0);
+        }
+        close(tasks[0]);
+        close(done[1]);
+        m_tasks = tasks[1];
+        m_done = done[0];
+    }
+
+    /**
+     * @brief Sends a batch. Returns false if the process is gone.
+     */
+    bool send(const case_batch& batch) {
+        busy = true;
+        this->batch = batch;
+        return write(m_tasks, &batch, sizeof(batch)) == static_cast<ssize_t>(sizeof(batch));
+    }
+
+    /**
+     * @brief Kills the process and waits for it.
+     */
+    void kill_and_wait() {
+        ::kill(m_pid, SIGKILL);
+        wait();
+    }
+
+    /**
+     * @brief Waits for the process and closes the pipes. Sets threw, if the process was left by an exception.
+     * @return Returns the signal, which terminated the process, or 0.
+     */
+    int wait() {
+        close(m_tasks);
+        close(m_done);
+        int status = 0;
+        while (waitpid(m_pid, &status, 0) < 0 && errno == EINTR) {}
+        m_pid = -1;
+        busy = false;
+        threw = WIFEXITED(status) && WEXITSTATUS(status) == exception_exit_code;
+        return WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+    }
+
+    bool alive() const { return m_pid > 0; }
+    int tasks_fd() const { return m_tasks; }
+    int done_fd() const { return m_done; }
+
+    bool busy = false;
+    bool threw = false;
+    case_batch batch{ 0, 0 };
+
+private:
+    pid_t m_pid = -1;
+    int m_tasks = -1;
+    int m_done = -1;
+};
+
+/**
+ * @brief Worker side: executes batches until the task pipe is closed.
+ * @param exec Callable, which executes the case at a position.
+ */
+inline void worker_loop(int tasks, int done, worker_progress& progress, function_ref<void(size_t)> exec) {
+    case_batch batch;
+    while (read(tasks, &batch, sizeof(batch)) == static_cast<ssize_t>(sizeof(batch))) {
+        for (size_t i = batch.begin; i < batch.end; i++) {
+            progress.started.store(steady_now_ns(), std::memory_order_relaxed);
+            progress.current.store(i, std::memory_order_release);
+            exec(i);
+        }
+        progress.current.store(worker_progress::idle, std::memory_order_release);
+        const char ack = 1;
+        if (write(done, &ack, 1) != 1) break;
+    }
+}
+
+/**
+ * @brief Ignores SIGPIPE while it is alive, so writing to a crashed worker does not terminate the coordinator.
+ */
+class ignore_sigpipe {
+public:
+    ignore_sigpipe() {
+        struct sigaction ignore {};
+        ignore.sa_handler = SIG_IGN;
+        sigaction(SIGPIPE, &ignore, &m_previous);
+    }
+    ~ignore_sigpipe() { sigaction(SIGPIPE, &m_previous, nullptr); }
+
+    ignore_sigpipe(const ignore_sigpipe&) = delete;
+    ignore_sigpipe& operator=(const ignore_sigpipe&) = delete;
+
+private:
+    struct sigaction m_previous {};
+};
+
+/**
+ * @brief Executes the positions [0, count) in forked worker processes and watches them.
+ *
+ * The coordinator hands out batches of positions over pipes and watches the progress of every worker. A case which
+ * crashes its worker, throws or exceeds the timeout is passed to on_fault, the worker is replaced and the new worker continues
+ * the batch after that case. The results have to be written to shared memory by exec, so the finished cases of a batch
+ * survive a crash of its worker.
+ *
+ * @param exec Called in the worker processes with the worker index and the position of a case.
+ * @param on_fault Called in the coordinator with the position, the fault and the terminating signal of a failed case.
+ */
+inline void run_isolated(size_t count, size_t threads, size_t batch_size, std::chrono::nanoseconds case_timeout,
+                         function_ref<void(size_t, size_t)> exec, function_ref<void(size_t, case_fault, int)> on_fault) {
+    const size_t num_workers = std::min(resolve_thread_count(threads), std::max<size_t>(count, 1));
+    batch_size = std::max<size_t>(batch_size, 1);
+    const int64_t timeout = case_timeout.count();
+
+    shared_array<worker_progress> progress(num_workers);
+    std::vector<worker_process> workers(num_workers);
+    const ignore_sigpipe sigpipe;
+
+    const auto spawn = [&](size_t w) {
+        std::vector<int> inherited;
+        for (const auto& other : workers) {
+            if (other.alive()) inherited.insert(inherited.end(), { other.tasks_fd(), other.done_fd() });
+        }
+        progress[w].current.store(worker_progress::idle);
+        workers[w].spawn(inherited, [&, w](int tasks, int done) {
+            worker_loop(tasks, done, progress[w], [&, w](size_t i) { exec(w, i); });
+        });
+    };
+
+    // Replaces a worker after a fault and continues its batch after the faulty case.
+    const auto replace = [&](size_t w, size_t faulty, case_fault fault, int signal) {
+        const case_batch rest{ faulty + 1, workers[w].batch.end };
+        if (faulty != worker_progress::idle) on_fault(faulty, fault, signal);
+        spawn(w);
+        // A worker, which died between two cases, repeats its whole batch.
+        if (faulty == worker_progress::idle) workers[w].send(workers[w].batch);
+        else if (rest.begin < rest.end) workers[w].send(rest);
+    };
+
+    for (size_t w = 0; w < num_workers; w++) spawn(w);
+
+    const int poll_ms = static_cast<int>(std::clamp<int64_t>(timeout / 4'000'000, 1, 100));
+    std::vector<pollfd> fds;
+    std::vector<size_t> owners;
+    size_t next = 0;
+    while (true) {
+        for (size_t w = 0; w < num_workers && next < count; w++) {
+            if (workers[w].busy) continue;
+            workers[w].send({ next, std::min(next + batch_size, count) });
+            next = std::min(next + batch_size, count);
+        }
+
+        fds.clear();
+        owners.clear();
+        for (size_t w = 0; w < num_workers; w++) {
+            if (!workers[w].busy) continue;
+            fds.push_back({ workers[w].done_fd(), POLLIN, 0 });
+            owners.push_back(w);
+        }
+        if (fds.empty()) break;
+
+        if (poll(fds.data(), fds.size(), poll_ms) < 0 && errno != EINTR) throw std::runtime_error{ "poll failed" };
+
+        for (size_t k = 0; k < fds.size(); k++) {
+            const size_t w = owners[k];
+            if (fds[k].revents & (POLLIN | POLLHUP | POLLERR)) {
+                char ack;
+                if (read(fds[k].fd, &ack, 1) == 1) {
+                    workers[w].busy = false;
+                    continue;
+                }
+                // The pipe was closed, i.e. the worker died.
+                const size_t faulty = progress[w].current.load(std::memory_order_acquire);
+                const int signal = workers[w].wait();
+                replace(w, faulty, workers[w].threw ? case_fault::exception : case_fault::crash, signal);
+                continue;
+            }
+
+            // Watchdog: the start time is written before the position, so it belongs to the position read first.
+            const size_t current = progress[w].current.load(std::memory_order_acquire);
+            if (current == worker_progress::idle) continue;
+            const int64_t started = progress[w].started.load(std::memory_order_relaxed);
+            if (steady_now_ns() - started <= timeout || progress[w].current.load(std::memory_order_acquire) != current) continue;
+            workers[w].kill_and_wait();
+            replace(w, current, case_fault::timeout, 0);
+        }
+    }
+
+    for (auto& worker : workers) worker.wait();
+}
+
+}
+
+#endif
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+#include "constraint_proxy.hpp"
+
+namespace aut {
+
+/**
+ * @brief Latency budget of a function, declared on its return type.
+ *
+ * Behaves like the wrapped return constraint C. test_func times every generated case of a function returning this
+ * type and fails the cases, whose minimum latency over repeated calls exceeds the budget, like cases with an invalid
+ * return value. See test_options::budget_repetitions.
+ *
+ * @tparam MaxNs Maximum latency of a single call in ns.
+ * @tparam C Return constraint.
+ */
+template<uint64_t MaxNs, typename C> requires is_constrained<C>
+struct max_latency_ns : public C {
+    using C::C;
+
+    static constexpr uint64_t max_latency = MaxNs;
+};
+
+namespace detail {
+
+/**
+ * @brief Latency budget in ns of a return type, or 0 if it has none.
+ */
+template<typename T>
+inline constexpr uint64_t latency_budget_of = 0;
+
+template<uint64_t MaxNs, typename C>
+inline constexpr uint64_t latency_budget_of<max_latency_ns<MaxNs, C>> = MaxNs;
+
+}
+
+}
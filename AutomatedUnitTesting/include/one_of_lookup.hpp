@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUT_HAS_SSE2 1
+#endif
+
+namespace aut {
+
+/**
+ * @brief Strategies for checking whether a value is one of the options of a one_of constraint.
+ */
+enum class lookup_strategy {
+    fold,          ///< Chain of comparisons "v == A || v == B || ...". Used for small packs.
+    bitmask,       ///< Single bit test in a bitmap over [min, max] of the options. Used for dense integer packs.
+    simd,          ///< Branchless comparison with all options, 4 at a time with SSE2. Used for mid-size packs.
+    binary_search  ///< Binary search in the sorted options. Used for large sparse packs.
+};
+
+namespace detail {
+
+/**
+ * @brief Precomputed lookup tables for the options of a one_of constraint.
+ *
+ * The strategy is selected at compile time from the option pack, see lookup_strategy. All strategies give the same
+ * result as the comparison chain, including the handling of -0.0 and NaN for floating point options.
+ *
+ * @tparam T Value type of the constraint.
+ * @tparam Options Option values, which are converted to T.
+ */
+template<typename T, auto... Options>
+struct one_of_lookup {
+    static constexpr size_t size = sizeof...(Options);
+
+    /**
+     * @brief Maximum number of options, for which the comparison chain is used.
+     */
+    static constexpr size_t max_fold_size = 8;
+
+    /**
+     * @brief Maximum number of options, for which the SIMD comparison is used.
+     */
+    static constexpr size_t max_simd_size = 64;
+
+    /**
+     * @brief Maximum number of bits in the bitmap. Larger bitmaps no longer fit into the L1 cache next to the caller's data.
+     */
+    static constexpr size_t max_bitmask_bits = 4096;
+
+    static constexpr bool bitmask_candidate = std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t);
+    static constexpr bool simd_candidate = (std::same_as<T, float> || (std::integral<T> && sizeof(T) == 4));
+
+    using unsigned_type = std::make_unsigned_t<std::conditional_t<bitmask_candidate, T, int>>;
+
+    static constexpr T min_option = [] {
+        std::array<T, size> values{ static_cast<T>(Options)... };
+        return *std::min_element(values.begin(), values.end());
+    }();
+
+    /**
+     * @brief Distance between the smallest and the largest option, i.e. the number of bits of the bitmap minus one.
+     */
+    static constexpr uint64_t span = [] {
+        if constexpr (bitmask_candidate) {
+            std::array<T, size> values{ static_cast<T>(Options)... };
+            const T max_option = *std::max_element(values.begin(), values.end());
+            return static_cast<uint64_t>(static_cast<unsigned_type>(static_cast<unsigned_type>(max_option) - static_cast<unsigned_type>(min_option)));
+        }
+        else {
+            return uint64_t{ 0 };
+        }
+    }();
+
+    static constexpr lookup_strategy strategy = [] {
+        if (size <= max_fold_size) return lookup_strategy::fold;
+        // Dense: at most 64 bits (one word) per option.
+        if (bitmask_candidate && span < max_bitmask_bits && span / 64 < size) return lookup_strategy::bitmask;
+        if (simd_candidate && size <= max_simd_size) return lookup_strategy::simd;
+        return lookup_strategy::binary_search;
+    }();
+
+    static constexpr size_t bitmask_words = strategy == lookup_strategy::bitmask ? static_cast<size_t>(span / 64 + 1) : 1;
+
+    static constexpr std::array<uint64_t, bitmask_words> bitmask = [] {
+        std::array<uint64_t, bitmask_words> bits{};
+        if constexpr (strategy == lookup_strategy::bitmask) {
+            for (const T v : { static_cast<T>(Options)... }) {
+                const auto d = static_cast<uint64_t>(static_cast<unsigned_type>(static_cast<unsigned_type>(v) - static_cast<unsigned_type>(min_option)));
+                bits[d / 64] |= uint64_t{ 1 } << (d % 64);
+            }
+        }
+        return bits;
+    }();
+
+    /**
+     * @brief Options padded to a multiple of 4 with copies of the first option, which does not change the result.
+     */
+    static constexpr size_t padded_size = (size + 3) / 4 * 4;
+
+    static constexpr std::array<T, padded_size> padded = [] {
+        std::array<T, padded_size> values{};
+        const std::array<T, size> options{ static_cast<T>(Options)... };
+        for (size_t i = 0; i < padded_size; i++) values[i] = i < size ? options[i] : options[0];
+        return values;
+    }();
+
+    /**
+     * @brief Number of options, which can compare equal to a value. NaN options never do and are dropped.
+     */
+    static constexpr size_t sorted_size = ((static_cast<T>(Options) == static_cast<T>(Options) ? 1 : 0) + ...);
+
+    static constexpr std::array<T, sorted_size> sorted = [] {
+        std::array<T, sorted_size> values{};
+        size_t i = 0;
+        for (const T v : { static_cast<T>(Options)... }) {
+            if (v == v) values[i++] = v;
+        }
+        std::sort(values.begin(), values.end());
+        return values;
+    }();
+
+    /**
+     * @brief Checks whether a value is equal to one of the options.
+     * @tparam S Lookup strategy. Defaults to the strategy selected for the option pack.
+     * @param v Value to check.
+     * @return Returns true if v compares equal to at least one option.
+     */
+    template<lookup_strategy S = strategy>
+    static constexpr bool contains(T v) {
+        if constexpr (S == lookup_strategy::fold) {
+            // Expands to the same comparison chain as a hand-written "v == A || v == B || ...".
+            return ((v == static_cast<T>(Options)) || ...);
+        }
+        else if constexpr (S == lookup_strategy::bitmask) {
+            static_assert(bitmask_candidate, "The bitmask lookup requires integral options.");
+            const auto d = static_cast<uint64_t>(static_cast<unsigned_type>(static_cast<unsigned_type>(v) - static_cast<unsigned_type>(min_option)));
+            return d <= span && ((bitmask[d / 64] >> (d % 64)) & 1) != 0;
+        }
+        else if constexpr (S == lookup_strategy::simd) {
+#ifdef AUT_HAS_SSE2
+            if (!std::is_constant_evaluated()) {
+                if constexpr (simd_candidate) return contains_sse2(v);
+            }
+#endif
+            bool found = false;
+            for (const T& o : padded) found |= (o == v);
+            return found;
+        }
+        else {
+            const auto it = std::lower_bound(sorted.begin(), sorted.end(), v);
+            return it != sorted.end() && *it == v;
+        }
+    }
+
+private:
+#ifdef AUT_HAS_SSE2
+    static bool contains_sse2(T v) {
+        if constexpr (std::same_as<T, float>) {
+            const __m128 needle = _mm_set1_ps(v);
+            __m128 found = _mm_setzero_ps();
+            for (size_t i = 0; i < padded_size; i += 4) {
+                found = _mm_or_ps(found, _mm_cmpeq_ps(needle, _mm_loadu_ps(padded.data() + i)));
+            }
+            return _mm_movemask_ps(found) != 0;
+        }
+        else {
+            const __m128i needle = _mm_set1_epi32(static_cast<int>(v));
+            __m128i found = _mm_setzero_si128();
+            for (size_t i = 0; i < padded_size; i += 4) {
+                found = _mm_or_si128(found, _mm_cmpeq_epi32(needle, _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded.data() + i))));
+            }
+            return _mm_movemask_epi8(found) != 0;
+        }
+    }
+#endif
+};
+
+}
+
+}
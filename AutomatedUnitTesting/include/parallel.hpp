@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aut {
+namespace detail {
+
+template<typename Signature>
+class function_ref;
+
+/**
+ * @brief Non-owning reference to a callable.
+ *
+ * The runners pass the work of a case through this reference, so their loops, threads and processes are compiled once
+ * instead of once per tested function. The callable has to outlive the reference.
+ */
+template<typename R, typename... Args>
+class function_ref<R(Args...)> {
+public:
+    template<typename F> requires (!std::is_same_v<std::remove_cvref_t<F>, function_ref> && std::is_invocable_r_v<R, F&, Args...>)
+    function_ref(F&& f) noexcept
+        : m_object(const_cast<void*>(static_cast<const void*>(std::addressof(f)))),
+          m_call([](void* object, Args... args) -> R {
+              return (*static_cast<std::remove_reference_t<F>*>(object))(std::forward<Args>(args)...);
+          }) {}
+
+    R operator()(Args... args) const { return m_call(m_object, std::forward<Args>(args)...); }
+
+private:
+    void* m_object;
+    R (*m_call)(void*, Args...);
+};
+
+/**
+ * @brief Returns the number of worker threads to use for a requested thread count.
+ * @param requested Requested number of threads. 0 selects the hardware concurrency.
+ * @return Returns a thread count of at least 1.
+ */
+inline size_t resolve_thread_count(size_t requested) {
+    if (requested == 0) requested = std::thread::hardware_concurrency();
+    return std::max<size_t>(requested, 1);
+}
+
+/**
+ * @brief Slice of the index space owned by a single worker.
+ *
+ * Chunks are claimed with an atomic fetch_add on "next", both by the owner and by
+ * stealing workers, so no lock is required. Each slice lives on its own cache line.
+ */
+struct alignas(64) work_range {
+    std::atomic<size_t> next{ 0 };
+    size_t end = 0;
+};
+
+/**
+ * @brief Executes body(begin, end, worker) for chunks of the index space [0, count) on a work-stealing set of threads.
+ *
+ * The index space is split into one contiguous slice per worker. A worker first drains its own slice and then steals
+ * chunks from the slices of the other workers. The calling thread participates as worker 0.
+ * Exceptions thrown by the body are rethrown on the calling thread after all workers finished.
+ *
+ * @param count Size of the index space.
+ * @param threads Number of workers. 0 selects the hardware concurrency.
+ * @param body Callable which processes the half-open index range [begin, end).
+ */
+inline void parallel_for(size_t count, size_t threads, function_ref<void(size_t, size_t, size_t)> body) {
+    const size_t num_workers = std::min(resolve_thread_count(threads), std::max<size_t>(count, 1));
+    if (num_workers == 1) {
+        if (count > 0) body(size_t{ 0 }, count, size_t{ 0 });
+        return;
+    }
+
+    // Small chunks keep the load balanced, but each claim is an atomic operation on a shared cache line.
+    const size_t chunk = std::max<size_t>(1, count / (num_workers * 16));
+
+    std::vector<work_range> ranges(num_workers);
+    for (size_t w = 0; w < num_workers; w++) {
+        ranges[w].next.store(count * w / num_workers, std::memory_order_relaxed);
+        ranges[w].end = count * (w + 1) / num_workers;
+    }
+
+    std::vector<std::exception_ptr> errors(num_workers);
+
+    auto worker = [&](size_t w) {
+        try {
+            for (size_t i = 0; i < num_workers; i++) {
+                work_range& r = ranges[(w + i) % num_workers];
+                while (true) {
+                    const size_t begin = r.next.fetch_add(chunk, std::memory_order_relaxed);
+                    if (begin >= r.end) break;
+                    body(begin, std::min(begin + chunk, r.end), w);
+                }
+            }
+        }
+        catch (...) {
+            errors[w] = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(num_workers - 1);
+        for (size_t w = 1; w < num_workers; w++) pool.emplace_back(worker, w);
+        worker(0);
+    }
+
+    for (const auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+}
+}
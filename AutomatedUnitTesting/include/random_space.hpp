@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "evaluation.hpp"
+#include "interval_set.hpp"
+
+namespace aut {
+
+namespace detail {
+
+/**
+ * @brief SplitMix64 generator. Small state, a few instructions per number and good enough statistical quality
+ *        for sampling test inputs.
+ */
+struct splitmix64 {
+    uint64_t state;
+
+    constexpr uint64_t operator()() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Uniform number in [0, n). n == 0 stands for 2^64.
+     */
+    constexpr uint64_t below(uint64_t n) {
+        const uint64_t r = (*this)();
+        return n == 0 ? r : r % n;
+    }
+
+    /**
+     * @brief Uniform number in [0, 1).
+     */
+    constexpr double uniform() {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+};
+
+/**
+ * @brief Generator of a single case. Each case gets its own stream, so a case can be regenerated from the seed and
+ *        its index alone, independent of the batch size and the number of threads.
+ */
+constexpr splitmix64 case_rng(uint64_t seed, uint64_t index) {
+    splitmix64 mix{ seed ^ (index * 0xd1342543de82ef95ull) };
+    return splitmix64{ mix() };
+}
+
+/**
+ * @brief Order-preserving mapping of values to unsigned keys.
+ *
+ * Neighbouring values have neighbouring keys. For floating point types every representable value has its own key,
+ * so sampling keys uniformly samples all magnitudes alike. -0.0 is ordered directly before +0.0.
+ */
+template<interval_type T>
+constexpr uint64_t to_key(T v) {
+    if constexpr (std::same_as<T, bool>) {
+        return v ? 1 : 0;
+    }
+    else if constexpr (std::integral<T>) {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<U>(static_cast<U>(v) - static_cast<U>(std::numeric_limits<T>::lowest()));
+    }
+    else {
+        using bits_type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        constexpr bits_type sign = bits_type{ 1 } << (sizeof(T) * 8 - 1);
+        const auto bits = std::bit_cast<bits_type>(v);
+        return (bits & sign) ? static_cast<bits_type>(~bits) : static_cast<bits_type>(bits | sign);
+    }
+}
+
+/**
+ * @brief Inverse of to_key().
+ */
+template<interval_type T>
+constexpr T from_key(uint64_t key) {
+    if constexpr (std::same_as<T, bool>) {
+        return key != 0;
+    }
+    else if constexpr (std::integral<T>) {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(static_cast<U>(static_cast<U>(key) + static_cast<U>(std::numeric_limits<T>::lowest())));
+    }
+    else {
+        using bits_type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        constexpr bits_type sign = bits_type{ 1 } << (sizeof(T) * 8 - 1);
+        const auto k = static_cast<bits_type>(key);
+        return std::bit_cast<T>((k & sign) ? static_cast<bits_type>(k ^ sign) : static_cast<bits_type>(~k));
+    }
+}
+
+/**
+ * @brief Samples values from the valid domain of a constraint.
+ *
+ * Constraints with an interval form are sampled uniformly over the keys (see to_key) of all valid values. With the
+ * boundary bias, a sample is instead taken from the few values next to a randomly chosen interval bound.
+ * Constraints without an interval form are sampled from their border values.
+ *
+ * @tparam C Constraint type.
+ */
+template<typename C>
+struct domain_sampler {
+    using value_type = typename evaluate<C>::value_type;
+
+    template<typename Rng>
+    static constexpr value_type sample(Rng& rng, double) {
+        constexpr auto& values = evaluate<C>::valid_border_values;
+        return values[rng.below(std::size(values))];
+    }
+};
+
+template<typename C> requires has_intervals<C>
+struct domain_sampler<C> {
+    using value_type = typename intervals_of<C>::value_type;
+    static constexpr const auto& set = intervals_of<C>::value;
+    static_assert(set.size > 0 || set.nan, "The constraint does not accept any value.");
+
+    /**
+     * @brief Number of values which are considered to be next to an interval bound.
+     */
+    static constexpr uint64_t boundary_width = 4;
+
+    /**
+     * @brief Number of keys in interval i. 0 stands for 2^64.
+     */
+    static constexpr uint64_t width(size_t i) {
+        return to_key(set.intervals[i].hi) - to_key(set.intervals[i].lo) + 1;
+    }
+
+    /**
+     * @brief Cumulative share of the intervals in all valid keys, used to pick an interval.
+     */
+    static constexpr std::array<double, set.size> cumulative = [] {
+        std::array<double, set.size> c{};
+        double sum = 0;
+        for (size_t i = 0; i < set.size; i++) {
+            sum += width(i) == 0 ? 0x1.0p64 : static_cast<double>(width(i));
+            c[i] = sum;
+        }
+        for (auto& v : c) v /= sum;
+        return c;
+    }();
+
+    template<typename Rng>
+    static constexpr value_type sample(Rng& rng, double boundary_bias) {
+        if constexpr (set.size == 0) {
+            return std::numeric_limits<value_type>::quiet_NaN();
+        }
+        else {
+            if (boundary_bias > 0 && rng.uniform() < boundary_bias) return sample_boundary(rng);
+
+            size_t i = 0;
+            if constexpr (set.size > 1) {
+                const double r = rng.uniform();
+                i = std::min<size_t>(std::upper_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin(), set.size - 1);
+            }
+            return from_key<value_type>(to_key(set.intervals[i].lo) + rng.below(width(i)));
+        }
+    }
+
+    /**
+     * @brief Lower or upper bound of an interval, which is not an end of the domain.
+     */
+    struct bound {
+        size_t interval;
+        bool upper;
+    };
+
+    static constexpr size_t num_bounds = [] {
+        size_t n = 0;
+        for (size_t i = 0; i < set.size; i++) {
+            n += (set.intervals[i].lo != domain_min<value_type>()) + (set.intervals[i].hi != domain_max<value_type>());
+        }
+        return n;
+    }();
+
+    static constexpr std::array<bound, num_bounds> bounds = [] {
+        std::array<bound, num_bounds> b{};
+        size_t n = 0;
+        for (size_t i = 0; i < set.size; i++) {
+            if (set.intervals[i].lo != domain_min<value_type>()) b[n++] = { i, false };
+            if (set.intervals[i].hi != domain_max<value_type>()) b[n++] = { i, true };
+        }
+        return b;
+    }();
+
+    /**
+     * @brief Samples one of the values next to the interval bounds, or NaN if it is valid.
+     *        Domains without any bound, e.g. less_eq<INT_MAX>, are sampled uniformly.
+     */
+    template<typename Rng>
+    static constexpr value_type sample_boundary(Rng& rng) {
+        const uint64_t n = num_bounds + (set.nan ? 1 : 0);
+        if (n == 0) return sample(rng, 0.);
+
+        const uint64_t b = rng.below(n);
+        if (b == num_bounds) return std::numeric_limits<value_type>::quiet_NaN();
+
+        const auto [i, upper] = bounds[b];
+        const uint64_t w = width(i);
+        const uint64_t offset = rng.below(w != 0 && w < boundary_width ? w : boundary_width);
+        if (!upper) return from_key<value_type>(to_key(set.intervals[i].lo) + offset);
+        return from_key<value_type>(to_key(set.intervals[i].hi) - offset);
+    }
+
+    /**
+     * @brief Returns the index of the interval which contains v, or set.size if there is none.
+     */
+    static constexpr size_t find(value_type v) {
+        for (size_t i = 0; i < set.size; i++) {
+            if (set.intervals[i].lo <= v && v <= set.intervals[i].hi) return i;
+        }
+        return set.size;
+    }
+};
+
+}
+
+/**
+ * @brief Randomly sampled test cases within the valid domains of all arguments.
+ *
+ * The counterpart of case_space for random testing. A case is identified by the seed and its index, and can be
+ * regenerated from these two numbers without generating the previous cases.
+ *
+ * @tparam Args Constrained argument types of the function under test.
+ */
+template<typename... Args>
+struct random_space {
+    using value_tuple = typename case_space<Args...>::value_tuple;
+
+    static constexpr size_t arity = sizeof...(Args);
+
+    /**
+     * @brief Returns the argument values of a single test case.
+     * @param seed Seed of the run.
+     * @param index Index of the test case.
+     * @param boundary_bias Probability in [0, 1], with which each argument is sampled next to a border of its domain.
+     * @return Returns a tuple with one value per argument.
+     */
+    static constexpr value_tuple at(uint64_t seed, uint64_t index, double boundary_bias = 0.) {
+        auto rng = detail::case_rng(seed, index);
+        // Braced initialization evaluates the samples from left to right.
+        return value_tuple{ detail::domain_sampler<std::remove_cvref_t<Args>>::sample(rng, boundary_bias)... };
+    }
+};
+
+namespace detail {
+
+template<typename T>
+struct random_space_of;
+
+template<template<typename...> typename C, typename... Args>
+struct random_space_of<C<Args...>> {
+    using type = random_space<Args...>;
+};
+
+}
+
+/**
+ * @brief Random space of a tuple-like list of argument types, e.g. std::tuple<Args...>.
+ */
+template<typename ArgList>
+using random_space_of = typename detail::random_space_of<ArgList>::type;
+
+}
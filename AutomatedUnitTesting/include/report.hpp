@@ -0,0 +1,738 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "helper.hpp"
+#include "isolation.hpp"
+#include "latency_budget.hpp"
+#include "parallel.hpp"
+
+namespace aut {
+
+/**
+ * @brief Verdict of a single test case.
+ * @tparam T Value type of the return constraint.
+ */
+template<typename T>
+struct case_result {
+    /**
+     * @brief Index of the case in the case_space of the function.
+     */
+    size_t case_index = 0;
+    bool passed = false;
+    /**
+     * @brief True if the case failed, because it exceeded the latency budget of the function.
+     */
+    bool over_budget = false;
+    T output{};
+    /**
+     * @brief Set by isolated runs, if the case did not return. The output is then meaningless.
+     */
+    case_fault fault = case_fault::none;
+    /**
+     * @brief Signal which terminated the worker process of a crashed case, or 0.
+     */
+    int signal = 0;
+
+    bool operator==(const case_result&) const = default;
+};
+
+namespace detail {
+
+/**
+ * @brief Makes a printable constraint from a returned value, which may be invalid.
+ */
+template<typename R>
+struct output_printer {
+    static R make(const typename R::value_type& v) { return R{ unchecked, v }; }
+};
+
+template<typename ...T>
+void print_tuple(std::ostream& os, const std::tuple<T...>& tuple) {
+    os << "(";
+    std::apply([&os](const auto& ... values) {
+        size_t i = 0;
+        ((os << (i++ > 0 ? ", " : "") << values), ...);
+    }, tuple);
+    os << ")";
+}
+
+}
+
+/**
+ * @brief Latencies of all cases of a run, see test_options::profile_repetitions.
+ */
+struct latency_profile {
+    /**
+     * @brief Minimum latency over the repetitions of each case in ns, in the order of the results. Empty if the
+     *        run was not profiled.
+     */
+    std::vector<double> latencies;
+
+    /**
+     * @brief Number of timed calls per case.
+     */
+    size_t repetitions = 0;
+
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+
+    /**
+     * @brief Number of cases per power of two, i.e. histogram[i] counts the latencies in [2^i, 2^(i+1)) ns.
+     */
+    std::vector<size_t> histogram;
+
+    /**
+     * @brief Positions of the slowest cases in the results, slowest first.
+     */
+    std::vector<size_t> slowest;
+
+    /**
+     * @brief Positions of all cases, which are slower than slow_factor times the median, in the order of the results.
+     */
+    std::vector<size_t> slow;
+
+    double slow_factor = 0;
+
+    bool empty() const { return latencies.empty(); }
+
+    /**
+     * @brief Computes the statistics from the latencies.
+     * @param slow_factor Cases slower than slow_factor times the median are flagged as slow.
+     * @param num_slowest Number of slowest cases to keep.
+     */
+    void analyze(double slow_factor, size_t num_slowest) {
+        this->slow_factor = slow_factor;
+        if (latencies.empty()) return;
+
+        std::vector<double> sorted = latencies;
+        std::sort(sorted.begin(), sorted.end());
+        p50 = detail::percentile(sorted, 0.50);
+        p90 = detail::percentile(sorted, 0.90);
+        p99 = detail::percentile(sorted, 0.99);
+        max = sorted.back();
+
+        histogram.assign(std::bit_width(static_cast<uint64_t>(max)) + 1, 0);
+        for (const double l : latencies) {
+            const auto ns = static_cast<uint64_t>(l);
+            histogram[ns == 0 ? 0 : std::bit_width(ns) - 1]++;
+        }
+
+        slowest.resize(latencies.size());
+        std::iota(slowest.begin(), slowest.end(), size_t{ 0 });
+        num_slowest = std::min(num_slowest, slowest.size());
+        std::partial_sort(slowest.begin(), slowest.begin() + num_slowest, slowest.end(),
+                          [this](size_t a, size_t b) { return latencies[a] > latencies[b]; });
+        slowest.resize(num_slowest);
+
+        slow.clear();
+        for (size_t i = 0; i < latencies.size(); i++) {
+            if (latencies[i] > slow_factor * p50) slow.push_back(i);
+        }
+    }
+
+    /**
+     * @brief Formats the statistics and the histogram. Cases are printed by the report, which knows their inputs.
+     */
+    void print_summary(std::ostream& os) const {
+        os << "Latency (minimum of " << repetitions << " calls per case): p50 " << p50 << " ns, p90 " << p90
+           << " ns, p99 " << p99 << " ns, max " << max << " ns" << '\n';
+        const size_t largest = *std::max_element(histogram.begin(), histogram.end());
+        for (size_t i = 0; i < histogram.size(); i++) {
+            if (histogram[i] == 0) continue;
+            std::ostringstream bounds;
+            bounds << '[' << (i == 0 ? 0 : uint64_t{ 1 } << i) << ", " << (uint64_t{ 1 } << (i + 1)) << ") ns";
+            const std::string range = bounds.str();
+            os << "  " << range << std::string(range.size() < 24 ? 24 - range.size() : 1, ' ') << histogram[i] << ' '
+               << std::string((histogram[i] * 40 + largest - 1) / largest, '#') << '\n';
+        }
+    }
+
+    /**
+     * @brief Formats the statistics, the slowest and the slow cases.
+     * @param print_inputs Prints the inputs of the case at a position of the results.
+     */
+    void print(std::ostream& os, detail::function_ref<void(std::ostream&, size_t)> print_inputs) const {
+        print_summary(os);
+        const auto print_case = [&](size_t i) {
+            os << "  input = ";
+            print_inputs(os, i);
+            os << ", latency = " << latencies[i] << " ns" << '\n';
+        };
+        os << "Slowest cases:" << '\n';
+        for (const size_t i : slowest) print_case(i);
+        if (!slow.empty()) {
+            os << slow.size() << " cases slower than " << slow_factor << "x the median:" << '\n';
+            for (const size_t i : slow) print_case(i);
+        }
+    }
+};
+
+/**
+ * @brief Result of all generated test cases of a function.
+ *
+ * The verdicts are stored in a buffer, which is allocated once before the cases are executed.
+ * The arguments of a case are not stored, they are recomputed from its case index when needed.
+ *
+ * @tparam Space case_space of the function under test.
+ * @tparam RetType Constrained return type of the function under test.
+ */
+template<typename Space, typename RetType>
+struct test_report {
+    using space_type = Space;
+    using arguments_type = typename Space::value_tuple;
+    using value_type = typename RetType::value_type;
+
+    /**
+     * @brief A failed case with its inputs and the returned value.
+     */
+    struct failure {
+        size_t case_index;
+        arguments_type arguments;
+        value_type output;
+        bool over_budget;
+        case_fault fault;
+        int signal;
+    };
+
+    /**
+     * @brief Latency budget of the function in ns, or 0 if it has none. See max_latency_ns.
+     */
+    static constexpr uint64_t latency_budget = detail::latency_budget_of<RetType>;
+
+    /**
+     * @brief Verdicts of all executed cases, in execution order.
+     */
+    std::vector<case_result<value_type>> results;
+
+    size_t num_passed = 0;
+    size_t num_failed = 0;
+
+    /**
+     * @brief Number of cases, which were not executed, because the return value is valid by construction. See
+     *        test_options::skip_proven.
+     */
+    size_t num_proven = 0;
+
+    /**
+     * @brief Wall time for executing all cases.
+     */
+    Duration duration{ 0 };
+
+    /**
+     * @brief Per-case latencies, if the run was profiled.
+     */
+    latency_profile profile;
+
+    /**
+     * @brief Number of executed cases.
+     */
+    size_t size() const { return results.size(); }
+
+    /**
+     * @brief True if no case failed.
+     */
+    bool passed() const { return num_failed == 0; }
+
+    /**
+     * @brief Returns the inputs and outputs of all failed cases.
+     */
+    std::vector<failure> failures() const {
+        std::vector<failure> f;
+        f.reserve(num_failed);
+        for (const auto& r : results) {
+            if (!r.passed) f.push_back({ r.case_index, Space::at(r.case_index), r.output, r.over_budget, r.fault, r.signal });
+        }
+        return f;
+    }
+
+    /**
+     * @brief Formats the report.
+     * @param os Output stream.
+     * @param verbose Also list the passed cases, not only the failed ones.
+     */
+    void print(std::ostream& os, bool verbose = false) const {
+        for (size_t i = 0; i < results.size(); i++) {
+            const auto& r = results[i];
+            if (r.passed && !verbose) continue;
+            os << (r.passed ? "PASSED" : "FAILED") << ", input = ";
+            detail::print_tuple(os, Space::at(r.case_index));
+            if (r.fault == case_fault::crash) os << ", crashed (signal " << r.signal << ")";
+            else if (r.fault == case_fault::timeout) os << ", timed out";
+            else if (r.fault == case_fault::exception) os << ", threw an exception";
+            else os << ", output = " << detail::output_printer<RetType>::make(r.output);
+            if (r.over_budget) os << ", latency = " << profile.latencies[i] << " ns (budget " << latency_budget << " ns)";
+            os << '\n';
+        }
+        if (!profile.empty()) {
+            profile.print(os, [this](std::ostream& out, size_t i) { detail::print_tuple(out, Space::at(results[i].case_index)); });
+        }
+        os << size() << " tests, " << num_passed << " passed, " << num_failed << " failed";
+        if (num_proven > 0) os << ", " << num_proven << " proven at compile time";
+        os << " (" << duration.count() << " ms)" << '\n';
+    }
+};
+
+/**
+ * @brief Overloaded left shift operator for printing the failed cases and the summary of a report.
+ */
+template<typename Space, typename RetType>
+std::ostream& operator<<(std::ostream& os, const test_report<Space, RetType>& report)
+{
+    report.print(os);
+    return os;
+}
+
+/**
+ * @brief Result of a differential run of a function against a reference implementation, see diff_test_func.
+ *
+ * @tparam Space case_space of the candidate function.
+ * @tparam T Value type of the compared return values.
+ */
+template<typename Space, typename T>
+struct diff_report {
+    using space_type = Space;
+    using arguments_type = typename Space::value_tuple;
+    using value_type = T;
+
+    /**
+     * @brief Outputs and latencies of a single case.
+     */
+    struct case_diff {
+        size_t case_index = 0;
+        bool passed = false;
+        T candidate_output{};
+        T reference_output{};
+        /**
+         * @brief Minimum latencies over the repetitions in ns, or 0 if the run was not timed.
+         */
+        double candidate_ns = 0;
+        double reference_ns = 0;
+
+        /**
+         * @brief Latency of the candidate relative to the reference, i.e. less than 1 where the candidate is faster.
+         */
+        double ratio() const { return candidate_ns / std::max(reference_ns, 1e-3); }
+    };
+
+    /**
+     * @brief A case, in which the candidate returned another value than the reference.
+     */
+    struct mismatch {
+        size_t case_index;
+        arguments_type arguments;
+        T candidate_output;
+        T reference_output;
+    };
+
+    /**
+     * @brief Outputs and latencies of all executed cases, in execution order.
+     */
+    std::vector<case_diff> results;
+
+    size_t num_passed = 0;
+    size_t num_failed = 0;
+
+    /**
+     * @brief Wall time for executing all cases.
+     */
+    Duration duration{ 0 };
+
+    /**
+     * @brief Number of timed calls of each function per case, see diff_options::repetitions.
+     */
+    size_t repetitions = 0;
+
+    /**
+     * @brief Geometric mean, median and extremes of the latency ratios of all cases.
+     */
+    double geomean_ratio = 0;
+    double p50_ratio = 0;
+    double min_ratio = 0;
+    double max_ratio = 0;
+
+    /**
+     * @brief Number of cases, in which the candidate was faster than the reference.
+     */
+    size_t num_faster = 0;
+
+    /**
+     * @brief Positions of the cases with the smallest and with the largest latency ratios in the results.
+     */
+    std::vector<size_t> fastest;
+    std::vector<size_t> slowest;
+
+    /**
+     * @brief Number of executed cases.
+     */
+    size_t size() const { return results.size(); }
+
+    /**
+     * @brief True if the candidate returned the same values as the reference in all cases.
+     */
+    bool passed() const { return num_failed == 0; }
+
+    /**
+     * @brief Returns the inputs and both outputs of all cases with different outputs.
+     */
+    std::vector<mismatch> mismatches() const {
+        std::vector<mismatch> m;
+        m.reserve(num_failed);
+        for (const auto& r : results) {
+            if (!r.passed) m.push_back({ r.case_index, Space::at(r.case_index), r.candidate_output, r.reference_output });
+        }
+        return m;
+    }
+
+    /**
+     * @brief Counts the verdicts and computes the statistics of the latency ratios.
+     * @param num_extremes Number of cases with the smallest and the largest ratios to keep.
+     */
+    void analyze(size_t num_extremes) {
+        num_passed = 0;
+        for (const auto& r : results) {
+            if (r.passed) num_passed++;
+        }
+        num_failed = results.size() - num_passed;
+        if (repetitions == 0 || results.empty()) return;
+
+        std::vector<double> ratios(results.size());
+        double log_sum = 0;
+        num_faster = 0;
+        for (size_t i = 0; i < results.size(); i++) {
+            ratios[i] = results[i].ratio();
+            log_sum += std::log(std::max(ratios[i], 1e-9));
+            if (results[i].candidate_ns < results[i].reference_ns) num_faster++;
+        }
+        geomean_ratio = std::exp(log_sum / static_cast<double>(ratios.size()));
+
+        std::vector<size_t> order(results.size());
+        std::iota(order.begin(), order.end(), size_t{ 0 });
+        std::sort(order.begin(), order.end(), [&ratios](size_t a, size_t b) { return ratios[a] < ratios[b]; });
+        min_ratio = ratios[order.front()];
+        max_ratio = ratios[order.back()];
+        std::vector<double> sorted(ratios.size());
+        for (size_t i = 0; i < order.size(); i++) sorted[i] = ratios[order[i]];
+        p50_ratio = detail::percentile(sorted, 0.50);
+
+        num_extremes = std::min(num_extremes, order.size());
+        fastest.assign(order.begin(), order.begin() + num_extremes);
+        slowest.assign(order.rbegin(), order.rbegin() + num_extremes);
+    }
+
+    /**
+     * @brief Formats the report.
+     * @param os Output stream.
+     * @param verbose Also list the matching cases, not only the mismatches.
+     */
+    void print(std::ostream& os, bool verbose = false) const {
+        for (const auto& r : results) {
+            if (r.passed && !verbose) continue;
+            os << (r.passed ? "PASSED" : "FAILED") << ", input = ";
+            detail::print_tuple(os, Space::at(r.case_index));
+            os << ", candidate = " << r.candidate_output << ", reference = " << r.reference_output << '\n';
+        }
+        if (repetitions > 0 && !results.empty()) {
+            os << "Latency of candidate / reference (minimum of " << repetitions << " calls per case): geomean "
+               << geomean_ratio << "x, p50 " << p50_ratio << "x, min " << min_ratio << "x, max " << max_ratio
+               << "x, faster in " << num_faster << " of " << results.size() << " cases" << '\n';
+            const auto print_case = [&](size_t i) {
+                const auto& r = results[i];
+                os << "  input = ";
+                detail::print_tuple(os, Space::at(r.case_index));
+                os << ", " << r.ratio() << "x (" << r.candidate_ns << " ns vs. " << r.reference_ns << " ns)" << '\n';
+            };
+            os << "Largest speedups:" << '\n';
+            for (const size_t i : fastest) print_case(i);
+            os << "Smallest speedups:" << '\n';
+            for (const size_t i : slowest) print_case(i);
+        }
+        os << size() << " tests, " << num_passed << " matched, " << num_failed << " mismatched ("
+           << duration.count() << " ms)" << '\n';
+    }
+};
+
+/**
+ * @brief Overloaded left shift operator for printing the mismatches, the latency ratios and the summary of a report.
+ */
+template<typename Space, typename T>
+std::ostream& operator<<(std::ostream& os, const diff_report<Space, T>& report)
+{
+    report.print(os);
+    return os;
+}
+
+/**
+ * @brief Result of a randomized run of a function, see fuzz_func.
+ *
+ * Only the number of passed cases and the failures with the smallest case indices are stored, so a run can
+ * execute millions of cases. The arguments of a case can be regenerated from the seed and its index.
+ *
+ * @tparam Space random_space of the function under test.
+ * @tparam RetType Constrained return type of the function under test.
+ */
+template<typename Space, typename RetType>
+struct fuzz_report {
+    using arguments_type = typename Space::value_tuple;
+    using value_type = typename RetType::value_type;
+
+    /**
+     * @brief A failed case with its inputs and the returned value, and the same after shrinking the inputs
+     *        towards the borders of their domains.
+     */
+    struct failure {
+        size_t case_index;
+        arguments_type arguments;
+        value_type output;
+        arguments_type shrunk_arguments;
+        value_type shrunk_output;
+    };
+
+    /**
+     * @brief Seed of the run. Running again with the same seed and options generates the same cases.
+     */
+    uint64_t seed = 0;
+
+    /**
+     * @brief Probability with which each argument was sampled next to a border of its domain.
+     */
+    double boundary_bias = 0;
+
+    size_t num_cases = 0;
+    size_t num_passed = 0;
+    size_t num_failed = 0;
+
+    /**
+     * @brief The failed cases with the smallest case indices, in ascending order.
+     */
+    std::vector<failure> failures;
+
+    /**
+     * @brief Wall time for executing all cases, without shrinking.
+     */
+    Duration duration{ 0 };
+
+    /**
+     * @brief Number of executed cases.
+     */
+    size_t size() const { return num_cases; }
+
+    /**
+     * @brief True if no case failed.
+     */
+    bool passed() const { return num_failed == 0; }
+
+    /**
+     * @brief Regenerates the arguments of a case of this run.
+     */
+    arguments_type arguments(size_t case_index) const { return Space::at(seed, case_index, boundary_bias); }
+
+    /**
+     * @brief Formats the failures and the summary.
+     */
+    void print(std::ostream& os) const {
+        for (const auto& f : failures) {
+            os << "FAILED, case = " << f.case_index << ", input = ";
+            detail::print_tuple(os, f.arguments);
+            os << ", output = " << detail::output_printer<RetType>::make(f.output) << ", shrunk input = ";
+            detail::print_tuple(os, f.shrunk_arguments);
+            os << ", output = " << detail::output_printer<RetType>::make(f.shrunk_output) << '\n';
+        }
+        os << size() << " random tests, " << num_passed << " passed, " << num_failed << " failed (seed " << seed
+           << ", " << duration.count() << " ms)" << '\n';
+    }
+};
+
+/**
+ * @brief Overloaded left shift operator for printing the failed cases and the summary of a fuzzing report.
+ */
+template<typename Space, typename RetType>
+std::ostream& operator<<(std::ostream& os, const fuzz_report<Space, RetType>& report)
+{
+    report.print(os);
+    return os;
+}
+
+/**
+ * @brief Result of an exhaustive run of a function over all valid values of its arguments, see exhaust_func.
+ *
+ * Like fuzz_report, only the counts and the failures with the smallest case indices are stored, as a domain may have
+ * billions of cases. The arguments of a case can be regenerated from its index.
+ *
+ * @tparam Space domain_space of the function under test.
+ * @tparam RetType Constrained return type of the function under test.
+ */
+template<typename Space, typename RetType>
+struct exhaust_report {
+    using arguments_type = typename Space::value_tuple;
+    using value_type = typename RetType::value_type;
+
+    struct failure {
+        uint64_t case_index;
+        arguments_type arguments;
+        value_type output;
+    };
+
+    uint64_t num_cases = 0;
+    uint64_t num_passed = 0;
+    uint64_t num_failed = 0;
+
+    /**
+     * @brief The failed cases with the smallest case indices, in ascending order.
+     */
+    std::vector<failure> failures;
+
+    /**
+     * @brief Wall time for executing all cases.
+     */
+    Duration duration{ 0 };
+
+    /**
+     * @brief Number of executed cases, i.e. the size of the domain.
+     */
+    uint64_t size() const { return num_cases; }
+
+    /**
+     * @brief True if no case failed.
+     */
+    bool passed() const { return num_failed == 0; }
+
+    /**
+     * @brief Regenerates the arguments of a case.
+     */
+    arguments_type arguments(uint64_t case_index) const { return Space::at(case_index); }
+
+    /**
+     * @brief Formats the failures and the summary.
+     */
+    void print(std::ostream& os) const {
+        for (const auto& f : failures) {
+            os << "FAILED, case = " << f.case_index << ", input = ";
+            detail::print_tuple(os, f.arguments);
+            os << ", output = " << detail::output_printer<RetType>::make(f.output) << '\n';
+        }
+        os << size() << " exhaustive tests, " << num_passed << " passed, " << num_failed << " failed ("
+           << duration.count() << " ms)" << '\n';
+    }
+};
+
+/**
+ * @brief Overloaded left shift operator for printing the failed cases and the summary of an exhaustive report.
+ */
+template<typename Space, typename RetType>
+std::ostream& operator<<(std::ostream& os, const exhaust_report<Space, RetType>& report)
+{
+    report.print(os);
+    return os;
+}
+
+/**
+ * @brief Result of a coverage-guided run of a function, see guided_fuzz_func.
+ *
+ * The inputs of a run depend on the edges, which the previous inputs reached, so the arguments of the failures are
+ * stored instead of being regenerated.
+ *
+ * @tparam Space case_space of the function under test, which provides the initial inputs.
+ * @tparam RetType Constrained return type of the function under test.
+ */
+template<typename Space, typename RetType>
+struct guided_report {
+    using arguments_type = typename Space::value_tuple;
+    using value_type = typename RetType::value_type;
+
+    /**
+     * @brief A failed case with its inputs and the returned value, and the same after shrinking the inputs
+     *        towards the borders of their domains.
+     */
+    struct failure {
+        size_t case_index;
+        arguments_type arguments;
+        value_type output;
+        arguments_type shrunk_arguments;
+        value_type shrunk_output;
+    };
+
+    /**
+     * @brief Seed of the run. The same seed, options and instrumented code generate the same inputs.
+     */
+    uint64_t seed = 0;
+
+    size_t num_cases = 0;
+    size_t num_passed = 0;
+    size_t num_failed = 0;
+
+    /**
+     * @brief Number of distinct edges, which the inputs reached. 0 if the function under test is not instrumented.
+     */
+    size_t edges = 0;
+
+    /**
+     * @brief Number of inputs in the corpus at the end of the run, i.e. the initial inputs and the ones which reached
+     *        new edges.
+     */
+    size_t corpus_size = 0;
+
+    /**
+     * @brief Index of the first case, which reached the most recently found edge.
+     */
+    size_t last_new_edge = 0;
+
+    /**
+     * @brief The failed cases with the smallest case indices, in ascending order.
+     */
+    std::vector<failure> failures;
+
+    /**
+     * @brief Wall time for executing all cases, without shrinking.
+     */
+    Duration duration{ 0 };
+
+    /**
+     * @brief Number of executed cases.
+     */
+    size_t size() const { return num_cases; }
+
+    /**
+     * @brief True if no case failed.
+     */
+    bool passed() const { return num_failed == 0; }
+
+    /**
+     * @brief Formats the failures and the summary.
+     */
+    void print(std::ostream& os) const {
+        for (const auto& f : failures) {
+            os << "FAILED, case = " << f.case_index << ", input = ";
+            detail::print_tuple(os, f.arguments);
+            os << ", output = " << detail::output_printer<RetType>::make(f.output) << ", shrunk input = ";
+            detail::print_tuple(os, f.shrunk_arguments);
+            os << ", output = " << detail::output_printer<RetType>::make(f.shrunk_output) << '\n';
+        }
+        os << size() << " guided tests, " << num_passed << " passed, " << num_failed << " failed, " << edges
+           << " edges, " << corpus_size << " inputs in corpus (seed " << seed << ", " << duration.count() << " ms)" << '\n';
+    }
+};
+
+/**
+ * @brief Overloaded left shift operator for printing the failed cases and the summary of a coverage-guided report.
+ */
+template<typename Space, typename RetType>
+std::ostream& operator<<(std::ostream& os, const guided_report<Space, RetType>& report)
+{
+    report.print(os);
+    return os;
+}
+
+}
@@ -0,0 +1,498 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "isolation.hpp"
+#include "parallel.hpp"
+
+namespace aut {
+
+/**
+ * @brief Summary of a run, which a reporter receives before its cases.
+ */
+struct run_summary {
+    /**
+     * @brief Name of the run, see test_options::name.
+     */
+    std::string_view name;
+    size_t num_cases = 0;
+    size_t num_passed = 0;
+    size_t num_failed = 0;
+    /**
+     * @brief Wall time for executing all cases in ms.
+     */
+    double duration_ms = 0;
+};
+
+/**
+ * @brief A single executed case with its values as text.
+ *
+ * Numbers are formatted with std::to_chars, i.e. in the shortest form which reads back to the same value. The views
+ * are only valid during the call of case_reporter::write_case.
+ */
+struct case_record {
+    size_t case_index = 0;
+    std::span<const std::string_view> arguments;
+    /**
+     * @brief Returned value. Empty if the case crashed or timed out.
+     */
+    std::string_view output;
+    bool passed = false;
+    bool over_budget = false;
+    case_fault fault = case_fault::none;
+    int signal = 0;
+    /**
+     * @brief Minimum latency of the case in ns, see test_report::profile.
+     */
+    double duration_ns = 0;
+};
+
+/**
+ * @brief Receives the cases of test_func runs, see test_options::reporters.
+ *
+ * The cases are passed after a run has finished, in the order of test_report::results, on the thread which started
+ * the run.
+ */
+class case_reporter {
+public:
+    virtual ~case_reporter() = default;
+
+    virtual void begin_run(const run_summary& summary) = 0;
+    virtual void write_case(const case_record& record) = 0;
+    virtual void end_run() = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief Collects text in a large buffer and writes full buffers to a stream on a background thread.
+ *
+ * There are two buffers: while the background thread writes one, the caller fills the other. The caller only waits if
+ * it fills its buffer faster than the stream drains the other one. The stream is flushed once per flush() call, not
+ * per record.
+ */
+class async_writer {
+public:
+    static constexpr size_t default_buffer_size = 1 << 20;
+
+    explicit async_writer(std::ostream& os, size_t buffer_size = default_buffer_size)
+        : m_os(os), m_buffer_size(std::max<size_t>(buffer_size, 1)) {
+        m_active.reserve(m_buffer_size + m_buffer_size / 4);
+        m_pending.reserve(m_buffer_size + m_buffer_size / 4);
+        m_thread = std::thread([this] { write_loop(); });
+    }
+
+    ~async_writer() {
+        hand_off();
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+        m_os.flush();
+    }
+
+    async_writer(const async_writer&) = delete;
+    async_writer& operator=(const async_writer&) = delete;
+
+    /**
+     * @brief Buffer to append to. Call commit() after each record.
+     */
+    std::string& buffer() { return m_active; }
+
+    /**
+     * @brief Hands the buffer to the background thread, once it is full.
+     */
+    void commit() {
+        if (m_active.size() >= m_buffer_size) hand_off();
+    }
+
+    void append(std::string_view text) {
+        m_active.append(text);
+        commit();
+    }
+
+    /**
+     * @brief Writes all appended text and flushes the stream.
+     * @throws std::runtime_error Thrown if the stream failed.
+     */
+    void flush() {
+        hand_off();
+        std::unique_lock lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_pending.empty(); });
+        m_os.flush();
+        if (!m_os) throw std::runtime_error{ "Writing the test records failed!" };
+    }
+
+private:
+    void hand_off() {
+        if (m_active.empty()) return;
+        {
+            std::unique_lock lock(m_mutex);
+            m_idle.wait(lock, [this] { return m_pending.empty(); });
+            std::swap(m_active, m_pending);
+        }
+        m_wake.notify_one();
+    }
+
+    void write_loop() {
+        std::unique_lock lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [this] { return !m_pending.empty() || m_stop; });
+            if (m_pending.empty()) return;
+            // The caller does not touch the pending buffer until it is empty again.
+            lock.unlock();
+            m_os.write(m_pending.data(), static_cast<std::streamsize>(m_pending.size()));
+            lock.lock();
+            m_pending.clear();
+            m_idle.notify_all();
+        }
+    }
+
+    std::ostream& m_os;
+    const size_t m_buffer_size;
+    std::string m_active;
+    std::string m_pending;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+/**
+ * @brief Appends a value in the shortest form, which reads back to the same value.
+ */
+template<typename T>
+void append_value(std::string& out, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        out += value ? "true" : "false";
+    }
+    else if constexpr (std::is_arithmetic_v<T>) {
+        std::array<char, 64> chars;
+        using number = std::conditional_t<std::is_integral_v<T> && sizeof(T) == 1, int, T>;
+        const auto [end, ec] = std::to_chars(chars.data(), chars.data() + chars.size(), static_cast<number>(value));
+        out.append(chars.data(), end);
+    }
+    else {
+        std::ostringstream os;
+        os << value;
+        out += os.str();
+    }
+}
+
+/**
+ * @brief Appends a time in s with ns resolution, as used by JUnit XML.
+ */
+inline void append_seconds(std::string& out, double seconds) {
+    std::array<char, 64> chars;
+    const auto [end, ec] = std::to_chars(chars.data(), chars.data() + chars.size(), seconds, std::chars_format::fixed, 9);
+    out.append(chars.data(), end);
+}
+
+/**
+ * @brief True if the text is a number in JSON syntax, i.e. not nan or inf.
+ */
+inline bool is_json_number(std::string_view text) {
+    if (!text.empty() && text.front() == '-') text.remove_prefix(1);
+    return !text.empty() && text.front() >= '0' && text.front() <= '9';
+}
+
+inline void append_json_string(std::string& out, std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += "\\u00";
+                out += hex[(c >> 4) & 0xf];
+                out += hex[c & 0xf];
+            }
+            else out += c;
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief Appends a value as JSON number, or as string if it is none.
+ */
+inline void append_json_value(std::string& out, std::string_view text) {
+    if (text == "true" || text == "false" || is_json_number(text)) out += text;
+    else append_json_string(out, text);
+}
+
+inline void append_xml_escaped(std::string& out, std::string_view text) {
+    for (const char c : text) {
+        switch (c) {
+        case '&': out += "&amp;"; break;
+        case '<': out += "&lt;"; break;
+        case '>': out += "&gt;"; break;
+        case '"': out += "&quot;"; break;
+        case '\'': out += "&apos;"; break;
+        default: out += c;
+        }
+    }
+}
+
+inline std::string_view fault_name(case_fault fault) {
+    switch (fault) {
+    case case_fault::crash: return "crash";
+    case case_fault::timeout: return "timeout";
+    case case_fault::exception: return "exception";
+    default: return "none";
+    }
+}
+
+/**
+ * @brief Output stream of a reporter: either a file, which the reporter owns, or a stream of the caller.
+ */
+class report_stream {
+public:
+    explicit report_stream(std::ostream& os) : m_os(&os) {}
+
+    explicit report_stream(const std::string& path) : m_file(std::in_place, path, std::ios::binary) {
+        if (!*m_file) throw std::runtime_error{ "Cannot open " + path + " for writing!" };
+        m_os = &*m_file;
+    }
+
+    std::ostream& get() { return *m_os; }
+
+private:
+    std::optional<std::ofstream> m_file;
+    std::ostream* m_os = nullptr;
+};
+
+}
+
+/**
+ * @brief Writes one JSON object per case and line (JSON Lines), e.g.
+ *        {"run":"f","case":3,"arguments":[0,-1.5],"output":2,"passed":true,"over_budget":false,"fault":"none","duration_ns":41}
+ */
+class jsonl_reporter : public case_reporter {
+public:
+    explicit jsonl_reporter(std::ostream& os, size_t buffer_size = detail::async_writer::default_buffer_size)
+        : m_stream(os), m_writer(m_stream.get(), buffer_size) {}
+
+    explicit jsonl_reporter(const std::string& path, size_t buffer_size = detail::async_writer::default_buffer_size)
+        : m_stream(path), m_writer(m_stream.get(), buffer_size) {}
+
+    void begin_run(const run_summary& summary) override {
+        m_prefix.clear();
+        m_prefix += "{\"run\":";
+        detail::append_json_string(m_prefix, summary.name);
+        m_prefix += ",\"case\":";
+    }
+
+    void write_case(const case_record& record) override {
+        std::string& out = m_writer.buffer();
+        out += m_prefix;
+        detail::append_value(out, record.case_index);
+        out += ",\"arguments\":[";
+        for (size_t i = 0; i < record.arguments.size(); i++) {
+            if (i > 0) out += ',';
+            detail::append_json_value(out, record.arguments[i]);
+        }
+        out += "],\"output\":";
+        if (record.fault == case_fault::none) detail::append_json_value(out, record.output);
+        else out += "null";
+        out += record.passed ? ",\"passed\":true" : ",\"passed\":false";
+        out += record.over_budget ? ",\"over_budget\":true" : ",\"over_budget\":false";
+        out += ",\"fault\":\"";
+        out += detail::fault_name(record.fault);
+        out += '"';
+        if (record.fault == case_fault::crash) {
+            out += ",\"signal\":";
+            detail::append_value(out, record.signal);
+        }
+        out += ",\"duration_ns\":";
+        detail::append_value(out, record.duration_ns);
+        out += "}\n";
+        m_writer.commit();
+    }
+
+    void end_run() override { m_writer.flush(); }
+
+private:
+    detail::report_stream m_stream;
+    detail::async_writer m_writer;
+    std::string m_prefix;
+};
+
+/**
+ * @brief Writes the runs as JUnit XML, one testsuite per run and one testcase per case.
+ *
+ * The testsuites element is closed when the reporter is destroyed, so a single file can hold several runs.
+ */
+class junit_reporter : public case_reporter {
+public:
+    explicit junit_reporter(std::ostream& os, size_t buffer_size = detail::async_writer::default_buffer_size)
+        : m_stream(os), m_writer(m_stream.get(), buffer_size) { open(); }
+
+    explicit junit_reporter(const std::string& path, size_t buffer_size = detail::async_writer::default_buffer_size)
+        : m_stream(path), m_writer(m_stream.get(), buffer_size) { open(); }
+
+    ~junit_reporter() override { m_writer.append("</testsuites>\n"); }
+
+    void begin_run(const run_summary& summary) override {
+        m_name.clear();
+        detail::append_xml_escaped(m_name, summary.name);
+
+        std::string& out = m_writer.buffer();
+        out += "  <testsuite name=\"";
+        out += m_name;
+        out += "\" tests=\"";
+        detail::append_value(out, summary.num_cases);
+        out += "\" failures=\"";
+        detail::append_value(out, summary.num_failed);
+        out += "\" errors=\"0\" time=\"";
+        detail::append_seconds(out, summary.duration_ms / 1e3);
+        out += "\">\n";
+        m_writer.commit();
+    }
+
+    void write_case(const case_record& record) override {
+        std::string& out = m_writer.buffer();
+        out += "    <testcase classname=\"";
+        out += m_name;
+        out += "\" name=\"";
+        out += m_name;
+        out += '(';
+        for (size_t i = 0; i < record.arguments.size(); i++) {
+            if (i > 0) out += ", ";
+            detail::append_xml_escaped(out, record.arguments[i]);
+        }
+        out += ")\" time=\"";
+        detail::append_seconds(out, record.duration_ns / 1e9);
+        if (record.passed) {
+            out += "\"/>\n";
+            m_writer.commit();
+            return;
+        }
+
+        out += "\">\n      <failure message=\"";
+        if (record.fault == case_fault::crash) {
+            out += "crashed (signal ";
+            detail::append_value(out, record.signal);
+            out += ')';
+        }
+        else if (record.fault == case_fault::timeout) out += "timed out";
+        else if (record.fault == case_fault::exception) out += "threw an exception";
+        else {
+            out += "output = ";
+            detail::append_xml_escaped(out, record.output);
+            if (record.over_budget) out += ", over latency budget";
+        }
+        out += "\"/>\n    </testcase>\n";
+        m_writer.commit();
+    }
+
+    void end_run() override {
+        m_writer.append("  </testsuite>\n");
+        m_writer.flush();
+    }
+
+private:
+    void open() { m_writer.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n"); }
+
+    detail::report_stream m_stream;
+    detail::async_writer m_writer;
+    std::string m_name;
+};
+
+namespace detail {
+
+/**
+ * @brief Passes the cases of a run to the reporters.
+ *
+ * The values of each case are formatted once into a reused buffer, which all reporters read.
+ *
+ * @param format Called with the position of a case, which fills the record and appends each argument to the text,
+ *        followed by its end offset, and then the returned value.
+ */
+inline void write_records(const run_summary& summary, size_t count, const std::vector<case_reporter*>& reporters,
+                          function_ref<void(size_t, case_record&, std::string&, std::vector<size_t>&)> format) {
+    for (case_reporter* r : reporters) r->begin_run(summary);
+
+    std::string text;
+    std::vector<size_t> ends;
+    std::vector<std::string_view> arguments;
+    for (size_t i = 0; i < count; i++) {
+        case_record record;
+        text.clear();
+        ends.clear();
+        format(i, record, text, ends);
+
+        // The views are taken after all values were appended, because appending may move the buffer.
+        arguments.clear();
+        size_t begin = 0;
+        for (const size_t end : ends) {
+            arguments.push_back(std::string_view{ text }.substr(begin, end - begin));
+            begin = end;
+        }
+        record.arguments = arguments;
+        record.output = std::string_view{ text }.substr(begin);
+        for (case_reporter* r : reporters) r->write_case(record);
+    }
+
+    for (case_reporter* r : reporters) r->end_run();
+}
+
+/**
+ * @brief Passes the cases of a finished run to the reporters.
+ * @param latencies Duration of each case in ns, or empty if the cases were not timed.
+ */
+template<typename Report>
+void write_records(const Report& report, std::string_view name, const std::vector<case_reporter*>& reporters,
+                   std::span<const double> latencies) {
+    if (reporters.empty()) return;
+
+    const run_summary summary{ name, report.size(), report.num_passed, report.num_failed,
+                               std::chrono::duration<double, std::milli>(report.duration).count() };
+    write_records(summary, report.size(), reporters,
+        [&report, latencies](size_t i, case_record& record, std::string& text, std::vector<size_t>& ends) {
+            const auto& result = report.results[i];
+            std::apply([&](const auto&... values) {
+                ((append_value(text, values), ends.push_back(text.size())), ...);
+            }, Report::space_type::at(result.case_index));
+            if (result.fault == case_fault::none) append_value(text, result.output);
+
+            record.case_index = result.case_index;
+            record.passed = result.passed;
+            record.over_budget = result.over_budget;
+            record.fault = result.fault;
+            record.signal = result.signal;
+            record.duration_ns = latencies.empty() ? 0. : latencies[i];
+        });
+}
+
+}
+
+}
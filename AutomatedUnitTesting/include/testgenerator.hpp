@@ -1,13 +1,293 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <tuple>
+#include <chrono>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "helper.hpp"
+#include "bulk_validation.hpp"
 #include "evaluation.hpp"
+#include "case_space.hpp"
+#include "random_space.hpp"
+#include "coverage_guided.hpp"
+#include "domain_space.hpp"
+#include "covering_array.hpp"
+#include "fixture.hpp"
+#include "isolation.hpp"
+#include "parallel.hpp"
+#include "report.hpp"
+#include "reporter.hpp"
 
 namespace aut {
+
+/**
+ * @brief Options which control how the generated test cases are executed.
+ */
+struct test_options {
+    /**
+     * @brief Print the argument candidates and every verdict, not only failures and the summary.
+     */
+    bool debug_prints = false;
+
+    /**
+     * @brief Number of worker threads. 1 runs all cases on the calling thread, 0 uses all hardware threads.
+     *
+     * With more than one thread, the function under test is called concurrently and must be thread-safe.
+     * The verdicts are still reported in the same order as in a single-threaded run.
+     */
+    size_t threads = 1;
+
+    /**
+     * @brief Which combinations of argument values are tested. The t-wise strategies only run a covering array
+     *        of the cartesian product of all argument candidates.
+     */
+    aut::coverage coverage = aut::coverage::exhaustive;
+
+    /**
+     * @brief Only run the cases at the positions [first_case, first_case + num_cases) of the run, e.g. to split a run
+     *        into shards. The positions are the indices of the case_space in exhaustive runs and the rows of the
+     *        covering array in t-wise runs. See register_test_func.
+     */
+    size_t first_case = 0;
+    size_t num_cases = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Do not execute functions, which return a bounded value. Their interval was derived at compile time from the
+     *        constraints of the operands, which only holds if every constrained value inside the function is valid. With
+     *        check_mode::none, nothing enforces that, e.g. for a constraint constructed from an out of range raw value,
+     *        so only enable this if all constraints inside the function are checked. See bounded and
+     *        interval_arithmetic_of.
+     */
+    bool skip_proven = false;
+
+    /**
+     * @brief Number of timed calls per case. 0 disables the latency profile, otherwise each case is called this many
+     *        times and its minimum latency is kept in test_report::profile.
+     */
+    size_t profile_repetitions = 0;
+
+    /**
+     * @brief Number of timed calls per case for functions with a latency budget (see max_latency_ns), if
+     *        profile_repetitions is 0. A case is over budget if even its fastest call is.
+     */
+    size_t budget_repetitions = 5;
+
+    /**
+     * @brief Cases slower than this factor times the median latency are flagged as slow.
+     */
+    double slow_factor = 4.0;
+
+    /**
+     * @brief Number of slowest cases, which are listed in the profile.
+     */
+    size_t slowest_cases = 5;
+
+    /**
+     * @brief Run the cases in forked worker processes (POSIX only, ignored elsewhere). A case which crashes or exceeds
+     *        case_timeout fails with its fault, and the other cases still run. threads is the number of processes.
+     */
+    bool isolate = false;
+
+    /**
+     * @brief Maximum time of a single case in isolated runs, before its worker process is killed.
+     */
+    std::chrono::milliseconds case_timeout{ 1000 };
+
+    /**
+     * @brief Number of cases, which are sent to a worker process at once in isolated runs.
+     */
+    size_t isolation_batch_size = 1024;
+
+    /**
+     * @brief Name of the run in the output of the reporters.
+     */
+    std::string name = "test_func";
+
+    /**
+     * @brief Receive every case after the run, e.g. a junit_reporter or a jsonl_reporter. They are owned by the
+     *        caller. If the run is not profiled, each case is timed once for the durations in the records.
+     */
+    std::vector<case_reporter*> reporters{};
+
+    /**
+     * @brief Print the report to std::cout after all cases were executed.
+     */
+    bool print = true;
+};
+
+/**
+ * @brief Options for randomized testing with fuzz_func.
+ */
+struct fuzz_options {
+    /**
+     * @brief Seed of the run. The same seed and options generate the same cases, independent of the thread count.
+     */
+    uint64_t seed = 0x5eed;
+
+    /**
+     * @brief Number of random cases.
+     */
+    size_t cases = 1'000'000;
+
+    /**
+     * @brief Probability in [0, 1], with which each argument is sampled next to a border of its domain instead of
+     *        uniformly from the whole domain.
+     */
+    double boundary_bias = 0.1;
+
+    /**
+     * @brief Number of worker threads. 1 runs all cases on the calling thread, 0 uses all hardware threads.
+     */
+    size_t threads = 1;
+
+    /**
+     * @brief Number of cases, which are generated at once before the function under test is called for them.
+     */
+    size_t batch_size = 4096;
+
+    /**
+     * @brief Maximum number of failures, which are kept in the report and shrunk.
+     */
+    size_t max_failures = 10;
+
+    /**
+     * @brief Move the arguments of each kept failure towards the borders of their domains, as long as the case still fails.
+     */
+    bool shrink = true;
+
+    /**
+     * @brief Print the report to std::cout after all cases were executed.
+     */
+    bool print = true;
+};
+
+/**
+ * @brief Options for differential testing with diff_test_func.
+ */
+struct diff_options {
+    /**
+     * @brief Floating point outputs, which differ by less than the tolerance, are equal, see float_equal. Other outputs
+     *        have to be equal.
+     */
+    double tolerance = 1e-4;
+
+    /**
+     * @brief Number of timed calls of each function per case. The minimum latencies are compared, see
+     *        diff_report::ratio. 0 only compares the outputs.
+     */
+    size_t repetitions = 5;
+
+    /**
+     * @brief Number of cases with the largest and the smallest speedups, which are listed in the report.
+     */
+    size_t extreme_cases = 3;
+
+    /**
+     * @brief Number of worker threads. 1 runs all cases on the calling thread, 0 uses all hardware threads.
+     */
+    size_t threads = 1;
+
+    /**
+     * @brief Which combinations of argument values are tested, see test_options::coverage.
+     */
+    aut::coverage coverage = aut::coverage::exhaustive;
+
+    /**
+     * @brief Also print the matching cases, not only the mismatches and the summary.
+     */
+    bool debug_prints = false;
+
+    /**
+     * @brief Print the report to std::cout after all cases were executed.
+     */
+    bool print = true;
+};
+
+/**
+ * @brief Options for coverage-guided testing with guided_fuzz_func.
+ */
+struct guided_options {
+    /**
+     * @brief Seed of the mutations.
+     */
+    uint64_t seed = 0x5eed;
+
+    /**
+     * @brief Number of executed cases, including the initial inputs.
+     */
+    size_t cases = 100'000;
+
+    /**
+     * @brief Maximum number of generated border value cases (see test_func), which form the initial corpus. They are
+     *        spread evenly over the case space. At least one case is generated, as the mutations need an input.
+     */
+    size_t max_seeds = 256;
+
+    /**
+     * @brief Maximum number of inputs in the corpus. Inputs, which reach new edges of a full corpus, are not kept.
+     */
+    size_t max_corpus = 4096;
+
+    /**
+     * @brief Maximum number of failures, which are kept in the report and shrunk.
+     */
+    size_t max_failures = 10;
+
+    /**
+     * @brief Move the arguments of each kept failure towards the borders of their domains, as long as the case still fails.
+     */
+    bool shrink = true;
+
+    /**
+     * @brief Print the report to std::cout after all cases were executed.
+     */
+    bool print = true;
+};
+
+/**
+ * @brief Options for exhaustive testing with exhaust_func.
+ */
+struct exhaust_options {
+    /**
+     * @brief Largest number of cases, i.e. product of the numbers of valid values of all arguments, which is executed.
+     *        Larger domains throw std::length_error instead of running for hours. The default covers all floats of a
+     *        single argument.
+     */
+    uint64_t max_cases = uint64_t{ 1 } << 32;
+
+    /**
+     * @brief Number of worker threads. 0 uses all hardware threads, 1 runs all cases on the calling thread.
+     */
+    size_t threads = 0;
+
+    /**
+     * @brief Number of consecutive cases, whose return values are collected and then validated at once with the
+     *        vector kernels of count_invalid.
+     */
+    size_t batch_size = 4096;
+
+    /**
+     * @brief Maximum number of failures, which are kept in the report.
+     */
+    size_t max_failures = 10;
+
+    /**
+     * @brief Print the report to std::cout after all cases were executed.
+     */
+    bool print = true;
+};
+
 namespace detail {
 
 template<typename T>
@@ -30,14 +310,25 @@ template<typename ClassType, typename RetType, typename ... Args>
 struct parse_signature<RetType(ClassType::*)(Args...)> {
     using return_type = RetType;
     using arg_types = std::tuple<Args...>;
+    using class_type = ClassType;
+    static constexpr bool is_const = false;
 };
 
 template<typename ClassType, typename RetType, typename ... Args>
 struct parse_signature<RetType(ClassType::*)(Args...) const> {
     using return_type = RetType;
     using arg_types = std::tuple<Args...>;
+    using class_type = ClassType;
+    static constexpr bool is_const = true;
 };
 
+/**
+ * @brief member_case of a member function pointer, see test_func.
+ */
+template<typename MemberFunc, typename Fixture>
+using member_case_of = member_case<MemberFunc, typename parse_signature<MemberFunc>::class_type, Fixture,
+                                   parse_signature<MemberFunc>::is_const>;
+
 template<typename ...Args>
 void printer(Args&&... args) {
     (std::cout << ... << args) << std::endl;
@@ -52,47 +343,146 @@ void print_array(const std::array<T, sz>& arr) {
     std::cout << std::endl;
 }
 
-template<typename ...T, size_t... Is>
-void print_arg_candidates_impl(const std::tuple<T...>& tuple, std::index_sequence<Is...>) {
-    ((std::cout << "Values for Argument " << Is << ": ", print_array(std::get<Is>(tuple))), ...);
+template<typename ...Args, size_t... Is>
+void print_arg_candidates_impl(std::index_sequence<Is...>) {
+    ((std::cout << "Values for Argument " << Is << ": ", print_array(evaluate<std::remove_cvref_t<Args>>::valid_border_values)), ...);
 }
 
-template<typename ...T>
-void print_arg_candidates(const std::tuple<T...>& tuple) {
-    print_arg_candidates_impl(tuple, std::make_index_sequence<sizeof...(T)>{});
+template<typename ...Args>
+void print_arg_candidates() {
+    print_arg_candidates_impl<Args...>(std::index_sequence_for<Args...>{});
 }
 
-template<typename Func, typename Arg0, typename ... Args>
-void exec_tests(Func& func, bool debug_prints, Arg0 arg0, Args ...  argVals) {
-    // TODO not very nice
-    for (const auto v : arg0) {
-        auto const newF = [v, func](auto &&... args) {return func(v, args...); };
-        exec_tests(newF, debug_prints, argVals...);
+/**
+ * @brief Calls the function under test repeatedly with the same arguments.
+ *
+ * The minimum over the repetitions filters out the noise of interrupts, preemption and cold caches in the first call.
+ * The latency of member functions includes the reset of the fixture object.
+ *
+ * @return Returns the result of the first call and the minimum latency in ns.
+ */
+template<typename RetType, typename Func, typename Tuple>
+std::pair<RetType, double> time_case(Func& func, size_t worker, const Tuple& args, size_t repetitions) {
+    using clock = std::chrono::steady_clock;
+    auto t1 = clock::now();
+    const RetType res = invoke_case(func, worker, args);
+    do_not_optimize(res.m_t);
+    auto t2 = clock::now();
+    double latency = std::chrono::duration<double, std::nano>(t2 - t1).count();
+
+    for (size_t r = 1; r < repetitions; r++) {
+        t1 = clock::now();
+        do_not_optimize(RetType{ invoke_case(func, worker, args) }.m_t);
+        t2 = clock::now();
+        latency = std::min(latency, std::chrono::duration<double, std::nano>(t2 - t1).count());
     }
+    return { res, latency };
 }
-template<typename Func>
-void exec_tests(Func& func, bool debug_prints) {
-    if (debug_prints) std::cout << "-----" << std::endl;
-    auto const res = func();
-    if (debug_prints) std::cout << "-----" << std::endl;
 
-    if (!res.is_valid()) {
-        std::cout << "FAILED, output = " << res << std::endl;
+/**
+ * @brief Executes a single case and stores its verdict, and with a latency pointer also its latency.
+ */
+template<typename RetType, typename Space, typename Func>
+void exec_case(Func& func, size_t worker, size_t index, size_t repetitions, case_result<typename RetType::value_type>& result,
+               double* latency) {
+    if (latency) {
+        const auto [res, l] = time_case<RetType>(func, worker, Space::at(index), repetitions);
+        result = { index, res.is_valid(), false, res.m_t };
+        *latency = l;
     }
     else {
-        if (debug_prints) std::cout << "PASSED, output = " << res << std::endl;
+        const RetType res = invoke_case(func, worker, Space::at(index));
+        result = { index, res.is_valid(), false, res.m_t };
     }
-    if (debug_prints) std::cout << "-----" << std::endl;
 }
 
-template<typename Func, typename ...T, size_t... Is>
-void call_with_arg_candidates_impl(Func& func, const std::tuple<T...>& tuple, std::index_sequence<Is...>, bool debug_prints) {
-    exec_tests(func, debug_prints, std::get<Is>(tuple) ...);
+/**
+ * @brief Maps the position of a case in a run to its index in the case_space: the identity for exhaustive runs, or
+ *        the rows of a covering array.
+ */
+struct case_selection {
+    const size_t* rows = nullptr;
+    /**
+     * @brief Position of the first case, see test_options::first_case.
+     */
+    size_t first = 0;
+
+    constexpr size_t operator()(size_t i) const { return rows ? rows[first + i] : first + i; }
+};
+
+/**
+ * @brief Executes the cases and stores their verdicts, and with a latencies buffer also their latencies.
+ */
+template<typename RetType, typename Space, typename Func>
+void exec_tests(Func& func, case_selection case_index, std::vector<case_result<typename RetType::value_type>>& results, size_t threads,
+                size_t repetitions = 0, std::vector<double>* latencies = nullptr) {
+    // Every case writes into its own preallocated slot, so the workers never synchronize on the results.
+    parallel_for(results.size(), threads, [&](size_t begin, size_t end, size_t w) {
+        // Invalid results are collected, not reported by the check policy.
+        const suspend_checks suspended;
+        for (size_t i = begin; i < end; i++) {
+            exec_case<RetType, Space>(func, w, case_index(i), repetitions, results[i], latencies ? &(*latencies)[i] : nullptr);
+        }
+    });
+}
+
+#ifdef AUT_HAS_FORK
+
+/**
+ * @brief Executes the cases in forked worker processes, see test_options::isolate and run_isolated.
+ *
+ * The verdicts and latencies are written into shared memory, so the finished cases of a batch survive a crash of its
+ * worker.
+ */
+template<typename RetType, typename Space, typename Func>
+void exec_isolated(Func& func, case_selection case_index, std::vector<case_result<typename RetType::value_type>>& results,
+                   const test_options& options, size_t repetitions = 0, std::vector<double>* latencies = nullptr) {
+    using result_type = case_result<typename RetType::value_type>;
+    const size_t num_tests = results.size();
+    shared_array<result_type> shared_results(num_tests);
+    shared_array<double> shared_latencies(latencies ? num_tests : 0);
+
+    run_isolated(num_tests, options.threads, options.isolation_batch_size, options.case_timeout,
+        [&](size_t w, size_t i) {
+            const suspend_checks suspended;
+            exec_case<RetType, Space>(func, w, case_index(i), repetitions, shared_results[i],
+                                      latencies ? &shared_latencies[i] : nullptr);
+        },
+        [&](size_t i, case_fault fault, int signal) {
+            result_type& r = shared_results[i];
+            r = { case_index(i), false, false };
+            r.fault = fault;
+            r.signal = signal;
+            if (latencies) {
+                shared_latencies[i] = fault == case_fault::timeout
+                    ? std::chrono::duration<double, std::nano>(options.case_timeout).count() : 0.;
+            }
+        });
+
+    for (size_t i = 0; i < num_tests; i++) results[i] = shared_results[i];
+    if (latencies) {
+        for (size_t i = 0; i < num_tests; i++) (*latencies)[i] = shared_latencies[i];
+    }
 }
 
-template<typename Func, typename ...T>
-void call_with_arg_candidates(Func& func, const std::tuple<T...>& tuple, bool debug_prints) {
-    call_with_arg_candidates_impl(func, tuple, std::make_index_sequence<sizeof...(T)>{}, debug_prints);
+#endif
+
+/**
+ * @brief Computes the covering array of the coverage strategy, or nothing for exhaustive runs, and announces the run.
+ * @return Returns the case indices of a t-wise run.
+ */
+inline std::vector<size_t> select_cases(std::span<const size_t> radices, size_t size, const test_options& options) {
+    if (options.coverage == coverage::exhaustive) {
+        if (options.print) std::cout << "Generating " << size << " tests!" << std::endl;
+        return {};
+    }
+
+    auto cases = covering_array(std::vector<size_t>(radices.begin(), radices.end()), static_cast<size_t>(options.coverage));
+    if (options.print) {
+        std::cout << "Generating " << cases.size() << " tests! (" << coverage_name(options.coverage) << " coverage of "
+                  << size << " cases, reduction ratio " << static_cast<double>(size) / cases.size() << ")" << std::endl;
+    }
+    return cases;
 }
 
 template<typename Func, typename RetType, typename T>
@@ -100,18 +490,445 @@ struct gen_testcases;
 
 template<typename Func, typename RetType, template<typename...> typename C, typename... Args>
 struct gen_testcases<Func, RetType, C<Args...>> {
-    gen_testcases(Func& func, bool debug_prints) {
-        constexpr auto arg_value_candidates = std::make_tuple(evaluate<Args>::valid_border_values ...);
-        const size_t num_tests = (std::size(evaluate<Args>::valid_border_values) * ...);
-        std::cout << "Generating " << num_tests << " tests!" << std::endl;
-        if (debug_prints) {
+    using space = case_space<Args...>;
+    using report_type = test_report<space, RetType>;
+
+    report_type report;
+
+    gen_testcases(Func& func, const test_options& options) {
+        const auto cases = select_cases(space::radices, space::size, options);
+        const bool exhaustive = options.coverage == coverage::exhaustive;
+        const size_t total = exhaustive ? space::size : cases.size();
+        const size_t first = std::min(options.first_case, total);
+        const size_t count = std::min(options.num_cases, total - first);
+        run(func, count, { exhaustive ? nullptr : cases.data(), first }, options);
+    }
+
+    void run(Func& func, size_t num_tests, case_selection case_index, const test_options& options) {
+        if (options.print && options.debug_prints) {
             std::cout << "Valid border values per argument are: " << std::endl;
-            print_arg_candidates(arg_value_candidates);
+            print_arg_candidates<Args...>();
         }
 
-        call_with_arg_candidates(func, arg_value_candidates, debug_prints);
+        if constexpr (detail::is_bounded<RetType>::value) {
+            if (options.skip_proven) {
+                report.num_proven = num_tests;
+                if (options.print) std::cout << report;
+                return;
+            }
+        }
+
+        report.results.resize(num_tests);
+        auto& profile = report.profile;
+        profile.repetitions = options.profile_repetitions;
+        if (report_type::latency_budget > 0 && profile.repetitions == 0) {
+            profile.repetitions = std::max<size_t>(options.budget_repetitions, 1);
+        }
+
+        // Reporters get the duration of every case from a single timed call, which does not enable the profile.
+        std::vector<double> record_latencies;
+        std::vector<double>* latencies = nullptr;
+        size_t repetitions = profile.repetitions;
+        if (profile.repetitions > 0) {
+            profile.latencies.resize(num_tests);
+            latencies = &profile.latencies;
+        }
+        else if (!options.reporters.empty()) {
+            record_latencies.resize(num_tests);
+            latencies = &record_latencies;
+            repetitions = 1;
+        }
+
+        const auto t1 = std::chrono::steady_clock::now();
+#ifdef AUT_HAS_FORK
+        if (options.isolate) exec_isolated<RetType, space>(func, case_index, report.results, options, repetitions, latencies);
+        else exec_tests<RetType, space>(func, case_index, report.results, options.threads, repetitions, latencies);
+#else
+        exec_tests<RetType, space>(func, case_index, report.results, options.threads, repetitions, latencies);
+#endif
+        const auto t2 = std::chrono::steady_clock::now();
+        report.duration = t2 - t1;
+        profile.analyze(options.slow_factor, options.slowest_cases);
+
+        if constexpr (report_type::latency_budget > 0) {
+            for (size_t i = 0; i < num_tests; i++) {
+                if (profile.latencies[i] <= static_cast<double>(report_type::latency_budget)) continue;
+                report.results[i].passed = false;
+                report.results[i].over_budget = true;
+            }
+        }
+
+        for (const auto& r : report.results) {
+            if (r.passed) report.num_passed++;
+        }
+        report.num_failed = num_tests - report.num_passed;
+
+        write_records(report, options.name, options.reporters, latencies ? std::span<const double>{ *latencies } : std::span<const double>{});
+
+        if (options.print) {
+            // Format everything first, so the stream is written and flushed only once.
+            std::ostringstream os;
+            report.print(os, options.debug_prints);
+            std::cout << os.str() << std::flush;
+        }
     }
 }; 
+
+/**
+ * @brief Executes random cases in batches and collects the failures with the smallest case indices.
+ */
+template<typename RetType, typename Space, typename Func>
+void exec_fuzzing(Func& func, const fuzz_options& options, fuzz_report<Space, RetType>& report) {
+    using value_tuple = typename Space::value_tuple;
+    using failure = typename fuzz_report<Space, RetType>::failure;
+
+    struct alignas(64) worker_state {
+        size_t num_passed = 0;
+        size_t num_failed = 0;
+        std::vector<failure> failures;
+        std::vector<value_tuple> batch;
+    };
+
+    const size_t batch_size = std::max<size_t>(options.batch_size, 1);
+    const size_t num_batches = (options.cases + batch_size - 1) / batch_size;
+    std::vector<worker_state> workers(resolve_thread_count(options.threads));
+
+    // Keeps the failures with the smallest indices, which are the same for any distribution of the batches.
+    const auto truncate = [&options](std::vector<failure>& failures) {
+        std::sort(failures.begin(), failures.end(), [](const failure& a, const failure& b) { return a.case_index < b.case_index; });
+        if (failures.size() > options.max_failures) failures.resize(options.max_failures);
+    };
+
+    parallel_for(num_batches, options.threads, [&](size_t begin, size_t end, size_t w) {
+        const suspend_checks suspended;
+        worker_state& state = workers[w];
+        state.batch.resize(batch_size);
+        for (size_t b = begin; b < end; b++) {
+            const size_t first = b * batch_size;
+            const size_t n = std::min(batch_size, options.cases - first);
+            for (size_t i = 0; i < n; i++) state.batch[i] = Space::at(options.seed, first + i, options.boundary_bias);
+
+            for (size_t i = 0; i < n; i++) {
+                const RetType res = invoke_case(func, w, state.batch[i]);
+                if (res.is_valid()) {
+                    state.num_passed++;
+                    continue;
+                }
+                state.num_failed++;
+                if (options.max_failures == 0) continue;
+                state.failures.push_back({ first + i, state.batch[i], res.m_t, state.batch[i], res.m_t });
+                if (state.failures.size() >= 2 * options.max_failures) truncate(state.failures);
+            }
+        }
+    });
+
+    for (auto& state : workers) {
+        report.num_passed += state.num_passed;
+        report.num_failed += state.num_failed;
+        report.failures.insert(report.failures.end(), state.failures.begin(), state.failures.end());
+    }
+    truncate(report.failures);
+}
+
+/**
+ * @brief Executes all cases of a domain space in batches and collects the failures with the smallest case indices.
+ *
+ * The return values of a batch are stored contiguously and validated with count_invalid, which uses the vector
+ * kernels for int32_t and float results. Only batches with invalid results are scanned for the failing cases.
+ */
+template<typename RetType, typename Space, typename Func>
+void exec_exhaustive(Func& func, const exhaust_options& options, exhaust_report<Space, RetType>& report) {
+    using failure = typename exhaust_report<Space, RetType>::failure;
+
+    struct alignas(64) worker_state {
+        uint64_t num_failed = 0;
+        std::vector<failure> failures;
+        std::vector<RetType> outputs;
+    };
+
+    const uint64_t num_cases = report.num_cases;
+    const size_t batch_size = std::max<size_t>(options.batch_size, 1);
+    const uint64_t num_batches = (num_cases + batch_size - 1) / batch_size;
+    std::vector<worker_state> workers(resolve_thread_count(options.threads));
+
+    const auto truncate = [&options](std::vector<failure>& failures) {
+        std::sort(failures.begin(), failures.end(), [](const failure& a, const failure& b) { return a.case_index < b.case_index; });
+        if (failures.size() > options.max_failures) failures.resize(options.max_failures);
+    };
+
+    parallel_for(num_batches, options.threads, [&](size_t begin, size_t end, size_t w) {
+        const suspend_checks suspended;
+        worker_state& state = workers[w];
+        state.outputs.reserve(batch_size);
+        for (size_t b = begin; b < end; b++) {
+            const uint64_t first = uint64_t{ b } * batch_size;
+            const uint64_t n = std::min<uint64_t>(batch_size, num_cases - first);
+            state.outputs.clear();
+            for (uint64_t i = 0; i < n; i++) state.outputs.push_back(invoke_case(func, w, Space::at(first + i)));
+
+            const std::span<const RetType> outputs{ state.outputs };
+            const size_t invalid = count_invalid(outputs);
+            if (invalid == 0) continue;
+            state.num_failed += invalid;
+            if (options.max_failures == 0) continue;
+            for (size_t i = first_invalid(outputs); i < n; i += 1 + first_invalid(outputs.subspan(i + 1))) {
+                state.failures.push_back({ first + i, Space::at(first + i), outputs[i].m_t });
+                if (state.failures.size() >= 2 * options.max_failures) truncate(state.failures);
+            }
+        }
+    });
+
+    for (auto& state : workers) {
+        report.num_failed += state.num_failed;
+        report.failures.insert(report.failures.end(), state.failures.begin(), state.failures.end());
+    }
+    report.num_passed = num_cases - report.num_failed;
+    truncate(report.failures);
+}
+
+/**
+ * @brief Mutates the inputs of a corpus and keeps the mutants, which reach new edges of the function under test.
+ *
+ * The corpus starts with border value cases. Each case mutates an input of the corpus, preferably the most recent one
+ * or the one which found more new edges of two random inputs. Runs on the calling thread, as each case depends on the
+ * coverage of the previous ones.
+ */
+template<typename RetType, typename Mutator, typename Space, typename Func>
+void exec_guided(Func& func, const guided_options& options, guided_report<Space, RetType>& report) {
+    using value_tuple = typename Space::value_tuple;
+
+    struct input {
+        value_tuple arguments;
+        size_t new_edges;
+    };
+
+    const suspend_checks suspended;
+    const auto map = std::make_unique<edge_map>();
+    const auto coverage = std::make_unique<edge_coverage>();
+    std::vector<input> corpus;
+    splitmix64 rng{ options.seed };
+
+    const auto execute = [&](const value_tuple& args, size_t index) {
+        const RetType res = [&] {
+            const trace_edges trace(*map);
+            return invoke_case(func, 0, args);
+        }();
+        if (res.is_valid()) {
+            report.num_passed++;
+        }
+        else {
+            report.num_failed++;
+            if (report.failures.size() < options.max_failures) report.failures.push_back({ index, args, res.m_t, args, res.m_t });
+        }
+        const size_t found = coverage->merge(*map);
+        if (found > 0) report.last_new_edge = index;
+        return found;
+    };
+
+    const size_t num_seeds = std::min({ std::max<size_t>(options.max_seeds, 1), Space::size, options.cases });
+    for (size_t i = 0; i < num_seeds; i++) {
+        const value_tuple args = Space::at(i * (Space::size / num_seeds));
+        corpus.push_back({ args, execute(args, i) });
+    }
+
+    size_t newest = corpus.size();
+    for (size_t index = num_seeds; index < options.cases; index++) {
+        size_t parent = newest;
+        if (parent == corpus.size() || rng.below(2) == 0) {
+            const size_t a = rng.below(corpus.size());
+            const size_t b = rng.below(corpus.size());
+            parent = corpus[a].new_edges >= corpus[b].new_edges ? a : b;
+        }
+        value_tuple args = corpus[parent].arguments;
+        Mutator::mutate(args, corpus[rng.below(corpus.size())].arguments, rng);
+
+        const size_t found = execute(args, index);
+        if (found > 0 && corpus.size() < options.max_corpus) {
+            corpus.push_back({ std::move(args), found });
+            newest = corpus.size() - 1;
+        }
+    }
+
+    report.edges = coverage->edges;
+    report.corpus_size = corpus.size();
+}
+
+/**
+ * @brief Moves the arguments of a failing case towards the borders of their domains, as long as it keeps failing.
+ *
+ * Each argument is moved towards the nearer bound of its interval first. If the case passes at the bound, a binary
+ * search over the values in between finds the failing value next to the passing ones, i.e. the border of the failing
+ * region. The arguments are shrunk in turn until none of them moves anymore.
+ */
+template<typename RetType, typename... Args>
+struct case_shrinker {
+    using value_tuple = typename random_space<Args...>::value_tuple;
+
+    /**
+     * @brief Upper bound for the number of rounds over all arguments.
+     */
+    static constexpr size_t max_rounds = 64;
+
+    template<typename Func>
+    static value_tuple shrink(Func& func, value_tuple args) {
+        for (size_t round = 0; round < max_rounds; round++) {
+            if (!shrink_round(func, args, std::index_sequence_for<Args...>{})) break;
+        }
+        return args;
+    }
+
+private:
+    template<typename Func>
+    static bool fails(Func& func, const value_tuple& args) {
+        // The shrinker runs on the calling thread, which is worker 0.
+        const RetType res = invoke_case(func, 0, args);
+        return !res.is_valid();
+    }
+
+    template<typename Func, size_t... Is>
+    static bool shrink_round(Func& func, value_tuple& args, std::index_sequence<Is...>) {
+        return (shrink_argument<Is>(func, args) | ...);
+    }
+
+    template<size_t I, typename Func>
+    static bool shrink_argument(Func& func, value_tuple& args) {
+        using arg_type = std::remove_cvref_t<std::tuple_element_t<I, std::tuple<Args...>>>;
+        using T = std::tuple_element_t<I, value_tuple>;
+        T& v = std::get<I>(args);
+
+        if constexpr (has_intervals<arg_type>) {
+            using sampler = domain_sampler<arg_type>;
+            const size_t i = sampler::find(v);
+            if (i == sampler::set.size) return false;
+
+            const auto& iv = sampler::set.intervals[i];
+            std::array<T, 2> targets{ iv.lo, iv.hi };
+            const bool bounded[2] = { iv.lo != domain_min<T>(), iv.hi != domain_max<T>() };
+            const uint64_t key = to_key(v);
+            const bool hi_first = bounded[1] && (!bounded[0] || to_key(iv.hi) - key < key - to_key(iv.lo));
+            for (size_t t = 0; t < 2; t++) {
+                const size_t j = hi_first ? 1 - t : t;
+                if (!bounded[j]) continue;
+                if (targets[j] == v) return false;
+                if (move_towards(func, args, v, targets[j])) return true;
+            }
+            return false;
+        }
+        else {
+            constexpr auto& borders = evaluate<arg_type>::valid_border_values;
+            if (std::find(borders.begin(), borders.end(), v) != borders.end()) return false;
+            const T original = v;
+            for (const auto& b : borders) {
+                v = b;
+                if (fails(func, args)) return true;
+            }
+            v = original;
+            return false;
+        }
+    }
+
+    template<typename Func, typename T>
+    static bool move_towards(Func& func, value_tuple& args, T& v, T target) {
+        const T original = v;
+        v = target;
+        if (fails(func, args)) return true;
+
+        // Invariant: the case fails at key "fail" and passes at key "pass".
+        uint64_t fail = to_key(original);
+        uint64_t pass = to_key(target);
+        while ((fail < pass ? pass - fail : fail - pass) > 1) {
+            const uint64_t mid = fail < pass ? fail + (pass - fail) / 2 : fail - (fail - pass) / 2;
+            v = from_key<T>(mid);
+            if (fails(func, args)) fail = mid;
+            else pass = mid;
+        }
+        v = from_key<T>(fail);
+        return fail != to_key(original);
+    }
+};
+
+template<typename RetType, typename T>
+struct case_shrinker_of;
+
+template<typename RetType, template<typename...> typename C, typename... Args>
+struct case_shrinker_of<RetType, C<Args...>> {
+    using type = case_shrinker<RetType, Args...>;
+};
+
+/**
+ * @brief Type of the compared outputs of a return type, i.e. the value type of constrained types.
+ */
+template<typename R>
+struct output_type {
+    using type = R;
+};
+
+template<typename R> requires is_constrained<R>
+struct output_type<R> {
+    using type = typename R::value_type;
+};
+
+/**
+ * @brief Return value of a function as the value type T, i.e. the wrapped value of constrained return types.
+ */
+template<typename T, typename R>
+T output_value(const R& r) {
+    if constexpr (is_constrained<R>) return static_cast<T>(r.m_t);
+    else return static_cast<T>(r);
+}
+
+/**
+ * @brief Compares the outputs of a candidate and a reference. Floating point outputs are compared with the tolerance,
+ *        and NaN is equal to NaN.
+ */
+template<typename T>
+bool outputs_equal(const T& candidate, const T& reference, double tolerance) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (candidate != candidate) return reference != reference;
+        return float_equal(candidate, reference, static_cast<T>(tolerance));
+    }
+    else {
+        return candidate == reference;
+    }
+}
+
+/**
+ * @brief Executes a single case with both functions and times them alternately, see diff_test_func.
+ */
+template<typename Space, typename T, typename Candidate, typename Reference, typename Result>
+void exec_diff_case(Candidate& candidate, Reference& reference, size_t worker, size_t index, const diff_options& options,
+                    Result& result) {
+    using clock = std::chrono::steady_clock;
+    const auto args = Space::at(index);
+    result.case_index = index;
+    result.candidate_output = output_value<T>(invoke_case(candidate, worker, args));
+    result.reference_output = output_value<T>(invoke_case(reference, worker, args));
+    result.passed = outputs_equal(result.candidate_output, result.reference_output, options.tolerance);
+
+    // Alternating the functions spreads drifts of the clock frequency evenly over both.
+    for (size_t r = 0; r < options.repetitions; r++) {
+        auto t1 = clock::now();
+        do_not_optimize(output_value<T>(invoke_case(candidate, worker, args)));
+        auto t2 = clock::now();
+        const double c = std::chrono::duration<double, std::nano>(t2 - t1).count();
+        t1 = clock::now();
+        do_not_optimize(output_value<T>(invoke_case(reference, worker, args)));
+        t2 = clock::now();
+        const double ref = std::chrono::duration<double, std::nano>(t2 - t1).count();
+        result.candidate_ns = r == 0 ? c : std::min(result.candidate_ns, c);
+        result.reference_ns = r == 0 ? ref : std::min(result.reference_ns, ref);
+    }
+}
+
+/**
+ * @brief Instantiated by static_test_func for the first failing case, so the compiler error lists the case index
+ *        and the generated input values as template arguments.
+ */
+template<size_t CaseIndex, auto... Inputs>
+struct static_test_failed {
+    static_assert(CaseIndex != CaseIndex, "Return constraint violated for the inputs listed in the template arguments!");
+    static constexpr bool value = false;
+};
 }
 
 template<typename Func>
@@ -119,12 +936,335 @@ struct test_func {
     using func_def = detail::parse_signature<Func>;
     using ret_type = typename func_def::return_type;
     using arg_types = typename func_def::arg_types;
+    using report_type = test_report<case_space_of<arg_types>, ret_type>;
+
+    /**
+     * @brief Verdicts, failed inputs and timing of all generated cases.
+     */
+    report_type report;
+
+    test_func(Func& func, const test_options& options = {}) {
+        run(func, options);
+    }
+
+    test_func(Func& func, bool debug_prints) : test_func(func, test_options{ .debug_prints = debug_prints }) {}
+
+    /**
+     * @brief Tests a member function on objects from a fixture, e.g. test_func{ &my_class::f, aut::fixture{ factory, reset } }.
+     *
+     * Each worker thread creates one object and resets it before each further case, see fixture.
+     * @param fixture Instance of fixture or a bare factory.
+     */
+    template<typename Fixture> requires std::is_member_function_pointer_v<Func>
+    test_func(Func func, Fixture&& fixture, const test_options& options = {}) {
+        auto f = detail::make_fixture(std::forward<Fixture>(fixture));
+        detail::member_case_of<Func, decltype(f)> member{ func, { std::move(f), options.threads } };
+        run(member, options);
+    }
+
+private:
+    template<typename F>
+    void run(F& func, const test_options& options) {
+        static_assert(is_constrained<ret_type>, "Function must have a constrained return type!");
+        report = std::move(detail::gen_testcases<F, ret_type, arg_types>{func, options}.report);
+    }
+};
+
+/**
+ * @brief Randomized testing of a function within the valid domains of its constrained arguments.
+ *
+ * Complements the border values of test_func with random values from the inside of the domains. Each argument is
+ * sampled uniformly from its domain or, with the boundary bias, next to one of its borders. Failing cases are shrunk
+ * towards the borders of the domains. The run is reproducible from the seed, which is printed with the summary.
+ *
+ * @tparam Func Function, function pointer or functor with constrained signature.
+ */
+template<typename Func>
+struct fuzz_func {
+    using func_def = detail::parse_signature<Func>;
+    using ret_type = typename func_def::return_type;
+    using arg_types = typename func_def::arg_types;
+    using space = random_space_of<arg_types>;
+    using report_type = fuzz_report<space, ret_type>;
+
+    /**
+     * @brief Counts, kept failures and timing of the run.
+     */
+    report_type report;
+
+    fuzz_func(Func& func, const fuzz_options& options = {}) {
+        run(func, options);
+    }
+
+    /**
+     * @brief Fuzzes a member function on objects from a fixture, see test_func.
+     */
+    template<typename Fixture> requires std::is_member_function_pointer_v<Func>
+    fuzz_func(Func func, Fixture&& fixture, const fuzz_options& options = {}) {
+        auto f = detail::make_fixture(std::forward<Fixture>(fixture));
+        detail::member_case_of<Func, decltype(f)> member{ func, { std::move(f), options.threads } };
+        run(member, options);
+    }
+
+private:
+    template<typename F>
+    void run(F& func, const fuzz_options& options) {
+        static_assert(is_constrained<ret_type>, "Function must have a constrained return type!");
+        report.seed = options.seed;
+        report.boundary_bias = options.boundary_bias;
+        report.num_cases = options.cases;
+
+        const auto t1 = std::chrono::steady_clock::now();
+        detail::exec_fuzzing<ret_type>(func, options, report);
+        const auto t2 = std::chrono::steady_clock::now();
+        report.duration = t2 - t1;
+
+        if (options.shrink) {
+            const suspend_checks suspended;
+            for (auto& f : report.failures) {
+                f.shrunk_arguments = detail::case_shrinker_of<ret_type, arg_types>::type::shrink(func, f.arguments);
+                const ret_type res = detail::invoke_case(func, 0, f.shrunk_arguments);
+                f.shrunk_output = res.m_t;
+            }
+        }
+
+        if (options.print) {
+            std::ostringstream os;
+            report.print(os);
+            std::cout << os.str() << std::flush;
+        }
+    }
+};
+
+/**
+ * @brief Coverage-guided testing of a function within the valid domains of its constrained arguments.
+ *
+ * Mutates argument tuples, which reached new control flow edges of the function under test, while keeping every
+ * argument inside its constraint. Branches, which depend on a few bytes or bits of an argument at a time, are found
+ * in far fewer cases than with fuzz_func. The edges are only traced in code compiled with -fsanitize-coverage=trace-pc
+ * (GCC and Clang) or trace-pc-guard (Clang), and the program has to be compiled with AUT_COVERAGE_GUIDED. Otherwise the
+ * mutations are not guided and the report shows 0 edges. Failing cases are shrunk like in fuzz_func.
+ *
+ * @tparam Func Function, function pointer or functor with constrained signature.
+ */
+template<typename Func>
+struct guided_fuzz_func {
+    using func_def = detail::parse_signature<Func>;
+    using ret_type = typename func_def::return_type;
+    using arg_types = typename func_def::arg_types;
+    using space = case_space_of<arg_types>;
+    using report_type = guided_report<space, ret_type>;
+
+    /**
+     * @brief Counts, coverage, kept failures and timing of the run.
+     */
+    report_type report;
+
+    guided_fuzz_func(Func& func, const guided_options& options = {}) {
+        run(func, options);
+    }
+
+    /**
+     * @brief Tests a member function on objects from a fixture, see test_func.
+     */
+    template<typename Fixture> requires std::is_member_function_pointer_v<Func>
+    guided_fuzz_func(Func func, Fixture&& fixture, const guided_options& options = {}) {
+        auto f = detail::make_fixture(std::forward<Fixture>(fixture));
+        detail::member_case_of<Func, decltype(f)> member{ func, { std::move(f), 1 } };
+        run(member, options);
+    }
+
+private:
+    template<typename F>
+    void run(F& func, const guided_options& options) {
+        static_assert(is_constrained<ret_type>, "Function must have a constrained return type!");
+        report.seed = options.seed;
+        report.num_cases = options.cases;
+
+        const auto t1 = std::chrono::steady_clock::now();
+        detail::exec_guided<ret_type, typename detail::case_mutator_of<arg_types>::type>(func, options, report);
+        const auto t2 = std::chrono::steady_clock::now();
+        report.duration = t2 - t1;
 
+        if (options.shrink) {
+            const suspend_checks suspended;
+            for (auto& f : report.failures) {
+                f.shrunk_arguments = detail::case_shrinker_of<ret_type, arg_types>::type::shrink(func, f.arguments);
+                const ret_type res = detail::invoke_case(func, 0, f.shrunk_arguments);
+                f.shrunk_output = res.m_t;
+            }
+        }
+
+        if (options.print) {
+            std::ostringstream os;
+            report.print(os);
+            std::cout << os.str() << std::flush;
+        }
+    }
+};
+
+/**
+ * @brief Exhaustive testing of a function over all valid values of its constrained arguments.
+ *
+ * Meant for small domains, e.g. 8 and 16 bit integers, narrow integer ranges or a float argument, where every value in
+ * the valid range is enumerated in steps of one ULP. The domain is split into batches, which run on all hardware threads
+ * by default, and the return values of each batch are validated at once. All arguments need an interval form, see
+ * intervals_of. Domains with more than exhaust_options::max_cases cases throw std::length_error.
+ *
+ * @tparam Func Function, function pointer or functor with constrained signature.
+ */
+template<typename Func>
+struct exhaust_func {
+    using func_def = detail::parse_signature<Func>;
+    using ret_type = typename func_def::return_type;
+    using arg_types = typename func_def::arg_types;
+    static_assert(detail::enumerable_args<arg_types>::value, "All arguments need an interval form, see intervals_of!");
+    using space = domain_space_of<arg_types>;
+    using report_type = exhaust_report<space, ret_type>;
+
+    /**
+     * @brief Counts, kept failures and timing of the run.
+     */
+    report_type report;
+
+    exhaust_func(Func& func, const exhaust_options& options = {}) {
+        run(func, options);
+    }
+
+    /**
+     * @brief Tests a member function on objects from a fixture, see test_func.
+     */
+    template<typename Fixture> requires std::is_member_function_pointer_v<Func>
+    exhaust_func(Func func, Fixture&& fixture, const exhaust_options& options = {}) {
+        auto f = detail::make_fixture(std::forward<Fixture>(fixture));
+        detail::member_case_of<Func, decltype(f)> member{ func, { std::move(f), options.threads } };
+        run(member, options);
+    }
 
-    test_func(Func& func, bool debug_prints=false) {
+private:
+    template<typename F>
+    void run(F& func, const exhaust_options& options) {
         static_assert(is_constrained<ret_type>, "Function must have a constrained return type!");
-        detail::gen_testcases<Func, ret_type, arg_types>{func, debug_prints};
-    }   
+        if (space::size > options.max_cases) {
+            throw std::length_error("exhaust_func: the domain has " + std::to_string(space::size) +
+                                    " cases, which is more than max_cases = " + std::to_string(options.max_cases));
+        }
+        report.num_cases = space::size;
+
+        const auto t1 = std::chrono::steady_clock::now();
+        detail::exec_exhaustive<ret_type>(func, options, report);
+        const auto t2 = std::chrono::steady_clock::now();
+        report.duration = t2 - t1;
+
+        if (options.print) {
+            std::ostringstream os;
+            report.print(os);
+            std::cout << os.str() << std::flush;
+        }
+    }
+};
+
+/**
+ * @brief Differential testing of a function against a reference implementation, e.g. an optimized function against a
+ *        simple one.
+ *
+ * Both functions are called with the generated arguments of the candidate, which must have a constrained signature.
+ * The reference is called with the same values and may take and return raw types. A case passes, if both return the
+ * same value, see diff_options::tolerance. The return constraint of the candidate is not checked, that is what
+ * test_func does. Each case is also timed with both functions, so the report shows where the candidate is faster.
+ *
+ * @tparam Candidate Function, function pointer or functor with constrained arguments.
+ * @tparam Reference Function, function pointer or functor, which accepts the argument values of the candidate.
+ */
+template<typename Candidate, typename Reference>
+struct diff_test_func {
+    using func_def = detail::parse_signature<Candidate>;
+    using ret_type = typename func_def::return_type;
+    using arg_types = typename func_def::arg_types;
+    using space = case_space_of<arg_types>;
+    using value_type = typename detail::output_type<ret_type>::type;
+    using report_type = diff_report<space, value_type>;
+
+    /**
+     * @brief Verdicts, outputs and latency ratios of all generated cases.
+     */
+    report_type report;
+
+    diff_test_func(Candidate& candidate, Reference& reference, const diff_options& options = {}) {
+        const auto cases = detail::select_cases(space::radices, space::size, { .coverage = options.coverage, .print = options.print });
+        const bool exhaustive = options.coverage == coverage::exhaustive;
+        const detail::case_selection case_index{ exhaustive ? nullptr : cases.data(), 0 };
+
+        report.results.resize(exhaustive ? space::size : cases.size());
+        report.repetitions = options.repetitions;
+
+        const auto t1 = std::chrono::steady_clock::now();
+        detail::parallel_for(report.results.size(), options.threads, [&](size_t begin, size_t end, size_t w) {
+            const suspend_checks suspended;
+            for (size_t i = begin; i < end; i++) {
+                detail::exec_diff_case<space, value_type>(candidate, reference, w, case_index(i), options, report.results[i]);
+            }
+        });
+        const auto t2 = std::chrono::steady_clock::now();
+        report.duration = t2 - t1;
+        report.analyze(options.extreme_cases);
+
+        if (options.print) {
+            std::ostringstream os;
+            report.print(os, options.debug_prints);
+            std::cout << os.str() << std::flush;
+        }
+    }
 };
 
-}
\ No newline at end of file
+/**
+ * @brief Executes all generated test-cases of a constexpr function at compile time.
+ *
+ * Every case is evaluated inside a constant expression. Constructing the object (e.g. "aut::static_test_func<f>{};")
+ * fails to compile if a return value violates its constraint, and the error names the failing case and its inputs.
+ * The static members can be inspected without triggering the error.
+ *
+ * @tparam Func constexpr function, function pointer or captureless lambda with constrained signature.
+ */
+template<auto Func>
+struct static_test_func {
+    using func_def = detail::parse_signature<std::remove_cvref_t<decltype(Func)>>;
+    using ret_type = typename func_def::return_type;
+    using arg_types = typename func_def::arg_types;
+    using space = case_space_of<arg_types>;
+
+    static_assert(is_constrained<ret_type>, "Function must have a constrained return type!");
+
+    /**
+     * @brief Index of the first case with an invalid return value, or space::size if all cases passed.
+     */
+    static constexpr size_t first_failure = [] {
+        for (size_t i = 0; i < space::size; i++) {
+            const ret_type res = std::apply(Func, space::at(i));
+            if (!res.is_valid()) return i;
+        }
+        return space::size;
+    }();
+
+    /**
+     * @brief True if all generated cases passed.
+     */
+    static constexpr bool passed = first_failure == space::size;
+
+    constexpr static_test_func() {
+        static_assert(report(std::make_index_sequence<space::arity>{}));
+    }
+
+private:
+    template<size_t... Is>
+    static constexpr bool report(std::index_sequence<Is...>) {
+        if constexpr (passed) {
+            return true;
+        }
+        else {
+            return detail::static_test_failed<first_failure, std::get<Is>(space::at(first_failure))...>::value;
+        }
+    }
+};
+
+}
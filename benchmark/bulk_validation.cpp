@@ -0,0 +1,69 @@
+// Runtime comparison of the bulk validation kernels with calling is_valid() element by element.
+// Build with -march=native (AUT_NATIVE_ARCH) to use AVX2 or AVX-512 instead of SSE2.
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "bulk_validation.hpp"
+#include "constraint_combiner.hpp"
+
+namespace {
+
+constexpr size_t num_values = 10'000'000;
+
+volatile size_t sink = 0;
+
+std::vector<aut::benchmark_result> results;
+
+template<typename C, typename T>
+std::vector<C> make_values(T min, T max) {
+    std::mt19937 rng{ 42 };
+    std::uniform_real_distribution<double> dist{ static_cast<double>(min), static_cast<double>(max) };
+    std::vector<C> values;
+    values.reserve(num_values);
+    for (size_t i = 0; i < num_values; i++) values.emplace_back(static_cast<T>(dist(rng)));
+    return values;
+}
+
+template<typename C>
+void compare(const std::string& name, const std::vector<C>& values) {
+    aut::benchmark_options options;
+    options.samples = 20;
+    options.warmup_samples = 2;
+
+    const auto bulk = aut::run_benchmark(name + "_count_invalid", [&] { sink = aut::count_invalid(values); }, options);
+    const auto all = aut::run_benchmark(name + "_all_valid", [&] { sink = aut::all_valid(values); }, options);
+    const auto scalar = aut::run_benchmark(name + "_scalar", [&] {
+        size_t count = 0;
+        for (const auto& v : values) count += !v.is_valid();
+        sink = count;
+    }, options);
+
+    const double bytes = static_cast<double>(values.size() * sizeof(C));
+    std::cout << bulk << all << scalar
+              << "  count_invalid: " << bytes / bulk.p50 << " GB/s, all_valid: " << bytes / all.p50
+              << " GB/s, scalar: " << bytes / scalar.p50 << " GB/s\n" << std::endl;
+    results.push_back(bulk);
+    results.push_back(all);
+    results.push_back(scalar);
+}
+
+}
+
+int main(int argc, char** argv) {
+    // All values are valid, so all_valid has to read the whole buffer.
+    compare("in_range_int", make_values<aut::in_range<0, 100, int>>(0, 100));
+    compare("nested_int", make_values<aut::_or<aut::_and<aut::greater<0>, aut::_not<aut::one_of<5, 6>>>, aut::less_eq<-100>>>(7, 1000));
+    compare("in_range_float", make_values<aut::in_range<-1.f, 1.f>>(-1.f, 1.f));
+    compare("or_float", make_values<aut::_or<aut::in_range<0.f, 10.f>, aut::one_of<100.f, 200.f>>>(0.f, 10.f));
+
+    // Usage: bulk_validation_benchmark [--json <file>]
+    if (argc == 3 && std::string{ argv[1] } == "--json") {
+        std::ofstream json{ argv[2] };
+        aut::write_json(json, results);
+    }
+}
@@ -0,0 +1,85 @@
+# Compares the generated assembly of "constrained_<name>" and "raw_<name>" function pairs.
+#
+# Usage: cmake -DASM_FILE=<file.s> [-DSTAMP_FILE=<file>] -P compare_asm.cmake
+#
+# Assembler directives are ignored and local labels are normalized, so only the instruction sequences are compared.
+# The script fails if the instructions of a pair differ, unless the pair is listed in known_differences below, or if no
+# pair was found.
+
+if(NOT ASM_FILE)
+    message(FATAL_ERROR "ASM_FILE is not set")
+endif()
+
+# Pairs, for which GCC 12 at -O2 emits different code, although the constrained function does the same work. They still
+# fail if the constrained function needs more instructions than the raw one.
+# - compare_greater_eq: the operands of the comparison are swapped (cmp b, a; setle instead of cmp a, b; setge).
+# - valid_nested: is_valid tests the merged intervals (-inf, -100], [1, 4] and [7, inf) in order and branches out early,
+#   the raw expression is evaluated without branches.
+# - bubble_sort: std::swap of the wrappers makes GCC address the compared elements relative to the second one.
+set(known_differences compare_greater_eq valid_nested bubble_sort)
+
+file(STRINGS "${ASM_FILE}" lines)
+
+set(functions "")
+set(current "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^_?([A-Za-z_][A-Za-z0-9_]*):")
+        set(current "${CMAKE_MATCH_1}")
+        set(body_${current} "")
+        set(count_${current} 0)
+        list(APPEND functions "${current}")
+    elseif(current STREQUAL "")
+        continue()
+    elseif(line MATCHES "^[ \t]*\\.size[ \t]")
+        set(current "")
+    elseif(line MATCHES "^\\.L[A-Za-z0-9_]*:")
+        string(APPEND body_${current} "label\n")
+    elseif(line MATCHES "^[ \t]*\\." OR line MATCHES "^[ \t]*#" OR line MATCHES "^[ \t]*$")
+        continue()
+    else()
+        string(REGEX REPLACE "#.*$" "" line "${line}")
+        string(REGEX REPLACE "\\.L[A-Za-z0-9_]+" ".L" line "${line}")
+        string(STRIP "${line}" line)
+        string(APPEND body_${current} "${line}\n")
+        math(EXPR count_${current} "${count_${current}} + 1")
+    endif()
+endforeach()
+
+set(num_pairs 0)
+set(num_identical 0)
+set(mismatches "")
+foreach(func IN LISTS functions)
+    if(NOT func MATCHES "^constrained_(.*)$")
+        continue()
+    endif()
+    set(name "${CMAKE_MATCH_1}")
+    if(NOT DEFINED body_raw_${name})
+        message(FATAL_ERROR "No raw_${name} found for constrained_${name}")
+    endif()
+    math(EXPR num_pairs "${num_pairs} + 1")
+    list(FIND known_differences "${name}" known)
+    if(body_constrained_${name} STREQUAL body_raw_${name})
+        math(EXPR num_identical "${num_identical} + 1")
+        if(known GREATER -1)
+            message(STATUS "${name}: listed as known difference, but the instructions are identical")
+        endif()
+    elseif(known GREATER -1 AND NOT count_constrained_${name} GREATER count_raw_${name})
+        message(STATUS "${name}: known difference, ${count_constrained_${name}} constrained vs ${count_raw_${name}} raw instructions")
+    else()
+        list(APPEND mismatches "${name}")
+        message(STATUS "constrained_${name} (${count_constrained_${name}} instructions):\n${body_constrained_${name}}")
+        message(STATUS "raw_${name} (${count_raw_${name}} instructions):\n${body_raw_${name}}")
+    endif()
+endforeach()
+
+if(num_pairs EQUAL 0)
+    message(FATAL_ERROR "No constrained_/raw_ function pairs found in ${ASM_FILE}")
+endif()
+if(mismatches)
+    message(FATAL_ERROR "Constraint wrappers change the generated code of: ${mismatches}")
+endif()
+
+message(STATUS "${num_identical} of ${num_pairs} constrained/raw function pairs with identical code, the others are known differences")
+if(STAMP_FILE)
+    file(TOUCH "${STAMP_FILE}")
+endif()
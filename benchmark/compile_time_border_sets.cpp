@@ -0,0 +1,50 @@
+// Compile-time benchmark for the border value set algebra in evaluation.hpp.
+// The benchmark is the compilation of this file: it instantiates the border values of a one_of with 1000 options
+// and of combinator trees with 16 levels. Build the target "compile_time_border_sets" to measure it.
+
+#include <iostream>
+#include <utility>
+
+#include "evaluation.hpp"
+
+namespace {
+
+// 1000 distinct options in scrambled order (7 is invertible modulo 1009).
+template<typename Seq>
+struct scrambled_one_of;
+
+template<size_t... Is>
+struct scrambled_one_of<std::index_sequence<Is...>> {
+    using type = aut::one_of<static_cast<int>(Is * 7 % 1009)...>;
+};
+
+using one_of_1k = typename scrambled_one_of<std::make_index_sequence<1000>>::type;
+
+// Each level adds two nested _and with ranges and an _or with a small one_of.
+template<size_t Depth>
+struct combinator_tree {
+    using child = typename combinator_tree<Depth - 1>::type;
+    static constexpr int D = static_cast<int>(Depth);
+
+    using type = aut::_or<
+        aut::_and<child, aut::_and<aut::in_range<-100 * D, 1000 + 100 * D>, aut::less<1500 - D>>>,
+        aut::one_of<-5 * D, 7 * D, 2000 + D>>;
+};
+
+template<>
+struct combinator_tree<0> {
+    using type = one_of_1k;
+};
+
+using tree_16 = typename combinator_tree<16>::type;
+using and_1k = aut::_and<one_of_1k, aut::in_range<100, 900>>;
+using or_1k = aut::_or<one_of_1k, typename scrambled_one_of<std::make_index_sequence<500>>::type>;
+
+}
+
+int main() {
+    std::cout << "one_of<1000>: " << std::size(aut::evaluate<one_of_1k>::valid_border_values) << " border values" << std::endl;
+    std::cout << "_and<one_of<1000>, in_range>: " << std::size(aut::evaluate<and_1k>::valid_border_values) << " border values" << std::endl;
+    std::cout << "_or<one_of<1000>, one_of<500>>: " << std::size(aut::evaluate<or_1k>::valid_border_values) << " border values" << std::endl;
+    std::cout << "16-level combinator tree: " << std::size(aut::evaluate<tree_16>::valid_border_values) << " border values" << std::endl;
+}
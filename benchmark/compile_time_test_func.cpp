@@ -0,0 +1,205 @@
+// Build-time benchmark of test_func: generates translation units with N tested functions of K constrained arguments
+// each, compiles every unit several times with the compiler of this build and reports the compile time and the peak
+// memory of the compiler process.
+//
+// Usage: compile_time_test_func [--functions N --arguments K] [--samples S] [--flags "<flags>"] [--include <dir>]
+//                               [--json <file>]
+// Without --functions and --arguments, a small grid of sizes is measured. --include replaces the include directory of
+// the library, e.g. to compare against the headers of another revision.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define AUT_HAS_WAIT4 1
+#endif
+
+namespace {
+
+struct compile_result {
+    size_t functions = 0;
+    size_t arguments = 0;
+    aut::benchmark_result time;
+    /**
+     * @brief Maximum resident set size of the compiler over all samples in MiB.
+     */
+    double peak_memory_mib = 0;
+};
+
+// Constraint templates of the generated arguments. {a} < {b} < {c} are replaced with numbers, which differ per
+// function and argument, so every function has its own signature and instantiations.
+const std::vector<std::string> argument_types = {
+    "aut::in_range<{a}, {b}>",
+    "aut::one_of<{a}, {b}, {c}>",
+    "aut::greater<{a}>",
+    "aut::_or<aut::less<{a}>, aut::in_range<{b}, {c}>>",
+    "aut::in_range<{a}.5f, {b}.5f>",
+    "aut::_and<aut::greater_eq<{a}>, aut::_not<aut::one_of<{b}>>>",
+};
+
+std::string replace_all(std::string text, const std::string& from, const std::string& to) {
+    for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size())) {
+        text.replace(pos, from.size(), to);
+    }
+    return text;
+}
+
+std::string generate_unit(size_t functions, size_t arguments) {
+    std::ostringstream os;
+    os << "#include \"testgenerator.hpp\"\n\n";
+    for (size_t f = 0; f < functions; f++) {
+        os << "aut::greater_eq<0> f" << f << "(";
+        for (size_t k = 0; k < arguments; k++) {
+            const long a = -static_cast<long>(f + k) - 1;
+            const long b = static_cast<long>(f + k) + 1;
+            std::string type = argument_types[(f + k) % argument_types.size()];
+            type = replace_all(type, "{a}", std::to_string(a));
+            type = replace_all(type, "{b}", std::to_string(b));
+            type = replace_all(type, "{c}", std::to_string(b + 50));
+            os << (k > 0 ? ", " : "") << type << " a" << k;
+        }
+        os << ") {\n    return 0";
+        for (size_t k = 0; k < arguments; k++) os << " + static_cast<int>(a" << k << ")";
+        os << ";\n}\n\n";
+    }
+    os << "int main() {\n";
+    for (size_t f = 0; f < functions; f++) os << "    aut::test_func{ f" << f << ", { .print = false } };\n";
+    os << "}\n";
+    return os.str();
+}
+
+std::vector<std::string> split_flags(const std::string& flags) {
+    std::istringstream is{ flags };
+    std::vector<std::string> result;
+    for (std::string flag; is >> flag;) result.push_back(flag);
+    return result;
+}
+
+#ifdef AUT_HAS_WAIT4
+
+/**
+ * @brief Runs the compiler and returns its wall time in ns and its peak memory in MiB.
+ */
+std::pair<double, double> run_compiler(const std::vector<std::string>& command) {
+    std::vector<char*> argv;
+    for (const auto& arg : command) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    const auto t1 = std::chrono::steady_clock::now();
+    const pid_t pid = fork();
+    if (pid < 0) throw std::runtime_error{ "fork failed" };
+    if (pid == 0) {
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    int status = 0;
+    rusage usage{};
+    while (wait4(pid, &status, 0, &usage) < 0 && errno == EINTR) {}
+    const auto t2 = std::chrono::steady_clock::now();
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) throw std::runtime_error{ "Compilation failed: " + command.back() };
+
+#ifdef __APPLE__
+    const double peak = static_cast<double>(usage.ru_maxrss) / (1024. * 1024.);
+#else
+    const double peak = static_cast<double>(usage.ru_maxrss) / 1024.;
+#endif
+    return { std::chrono::duration<double, std::nano>(t2 - t1).count(), peak };
+}
+
+compile_result measure(size_t functions, size_t arguments, size_t samples, const std::string& include,
+                       const std::string& flags) {
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string name = "aut_compile_" + std::to_string(functions) + "x" + std::to_string(arguments);
+    const auto source = (dir / (name + ".cpp")).string();
+    const auto object = (dir / (name + ".o")).string();
+    std::ofstream{ source } << generate_unit(functions, arguments);
+
+    std::vector<std::string> command = { AUT_CXX_COMPILER, "-std=c++" AUT_CXX_STANDARD, "-I" + include };
+    for (auto& flag : split_flags(flags)) command.push_back(std::move(flag));
+    command.insert(command.end(), { "-c", "-o", object, source });
+
+    compile_result r;
+    r.functions = functions;
+    r.arguments = arguments;
+    std::vector<double> times;
+    for (size_t s = 0; s < samples; s++) {
+        const auto [time, peak] = run_compiler(command);
+        times.push_back(time);
+        r.peak_memory_mib = std::max(r.peak_memory_mib, peak);
+    }
+    r.time = aut::summarize(name, std::move(times), 1);
+
+    std::filesystem::remove(source);
+    std::filesystem::remove(object);
+    return r;
+}
+
+#endif
+
+void write_json(std::ostream& os, const std::vector<compile_result>& results) {
+    os << "{\"compile_time\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        os << (i > 0 ? ",\n  " : "\n  ") << "{\"functions\": " << r.functions << ", \"arguments\": " << r.arguments
+           << ", \"peak_memory_mib\": " << r.peak_memory_mib << ", \"time\": ";
+        aut::write_json(os, r.time);
+        os << "}";
+    }
+    os << "\n]}\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+#ifdef AUT_HAS_WAIT4
+    std::vector<std::pair<size_t, size_t>> sizes = { { 10, 3 }, { 40, 3 }, { 10, 6 } };
+    size_t functions = 0;
+    size_t arguments = 0;
+    size_t samples = 3;
+    std::string flags = "-O0";
+    std::string include = AUT_INCLUDE_DIR;
+    std::string json;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        if (option == "--functions") functions = std::stoul(argv[i + 1]);
+        else if (option == "--arguments") arguments = std::stoul(argv[i + 1]);
+        else if (option == "--samples") samples = std::max<size_t>(std::stoul(argv[i + 1]), 1);
+        else if (option == "--flags") flags = argv[i + 1];
+        else if (option == "--include") include = argv[i + 1];
+        else if (option == "--json") json = argv[i + 1];
+        else {
+            std::cerr << "Unknown option " << option << std::endl;
+            return 1;
+        }
+    }
+    if (functions > 0 && arguments > 0) sizes = { { functions, arguments } };
+
+    std::vector<compile_result> results;
+    for (const auto& [n, k] : sizes) {
+        const auto r = measure(n, k, samples, include, flags);
+        std::cout << n << " functions x " << k << " arguments: p50 " << r.time.p50 / 1e9 << " s (min " << r.time.min / 1e9
+                  << " s, " << r.time.p50 / 1e6 / static_cast<double>(n) << " ms per function), peak memory "
+                  << r.peak_memory_mib << " MiB" << std::endl;
+        results.push_back(r);
+    }
+
+    if (!json.empty()) {
+        std::ofstream os{ json };
+        write_json(os, results);
+    }
+#else
+    (void)argc;
+    (void)argv;
+    std::cout << "The compile-time benchmark needs fork() and wait4()" << std::endl;
+#endif
+}
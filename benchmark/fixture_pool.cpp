@@ -0,0 +1,69 @@
+// Runtime comparison of testing a member function on pooled fixture objects with constructing an object per case.
+
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "testgenerator.hpp"
+
+namespace {
+
+// Stands for a class with an expensive constructor, e.g. one which loads tables, and a cheap reset.
+class lookup_table {
+public:
+    lookup_table() : m_table(64 * 1024) {
+        std::iota(m_table.begin(), m_table.end(), 0);
+    }
+
+    aut::greater_eq<0> lookup(aut::in_range<0, 1000> a, aut::one_of<1, 2, 4> b) {
+        m_lookups++;
+        return m_table[static_cast<size_t>(a * b)];
+    }
+
+    void reset() { m_lookups = 0; }
+
+private:
+    std::vector<int> m_table;
+    size_t m_lookups = 0;
+};
+
+std::vector<aut::benchmark_result> results;
+
+}
+
+int main(int argc, char** argv) {
+    aut::benchmark_options options;
+    options.samples = 5;
+    options.warmup_samples = 1;
+    options.min_sample_time = std::chrono::nanoseconds{ 0 };
+
+    constexpr size_t cases = 20'000;
+    const aut::fuzz_options fuzz{ .cases = cases, .print = false };
+
+    const auto pooled = aut::run_benchmark("pooled_fixture", [&] {
+        aut::do_not_optimize(aut::fuzz_func{ &lookup_table::lookup, [] { return lookup_table{}; }, fuzz }.report.num_passed);
+    }, options);
+
+    const auto per_case = [](aut::in_range<0, 1000> a, aut::one_of<1, 2, 4> b) -> aut::greater_eq<0> {
+        lookup_table table;
+        return table.lookup(a, b);
+    };
+    const auto constructed = aut::run_benchmark("constructed_per_case", [&] {
+        aut::do_not_optimize(aut::fuzz_func{ per_case, fuzz }.report.num_passed);
+    }, options);
+
+    std::cout << pooled << constructed
+              << "  pooled: " << pooled.p50 / cases << " ns/case, constructed per case: " << constructed.p50 / cases
+              << " ns/case, speedup " << constructed.p50 / pooled.p50 << "x" << std::endl;
+    results.push_back(pooled);
+    results.push_back(constructed);
+
+    // Usage: fixture_pool_benchmark [--json <file>]
+    if (argc == 3 && std::string{ argv[1] } == "--json") {
+        std::ofstream json{ argv[2] };
+        aut::write_json(json, results);
+    }
+}
@@ -0,0 +1,83 @@
+// Runtime comparison of the one_of lookup strategies with the comparison chain.
+// Each option pack is chosen such that one_of selects a different strategy for it.
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "constraints.hpp"
+
+namespace {
+
+constexpr size_t num_values = 4096;
+
+volatile int sink = 0;
+
+template<int Offset, int Stride, typename Seq>
+struct strided_one_of;
+
+template<int Offset, int Stride, size_t... Is>
+struct strided_one_of<Offset, Stride, std::index_sequence<Is...>> {
+    using type = aut::one_of<(Offset + Stride * static_cast<int>(Is))...>;
+};
+
+// 200 protocol codes in [100, 700).
+using dense = typename strided_one_of<100, 3, std::make_index_sequence<200>>::type;
+// 48 codes spread over [0, 48000).
+using mid = typename strided_one_of<7, 1000, std::make_index_sequence<48>>::type;
+// 500 codes spread over [0, 500000).
+using sparse = typename strided_one_of<11, 1000, std::make_index_sequence<500>>::type;
+
+static_assert(dense::lookup::strategy == aut::lookup_strategy::bitmask);
+static_assert(mid::lookup::strategy == aut::lookup_strategy::simd);
+static_assert(sparse::lookup::strategy == aut::lookup_strategy::binary_search);
+
+std::vector<aut::benchmark_result> results;
+
+// Queries hit an option in about half of the cases.
+template<typename OneOf>
+std::vector<int> make_queries(int max) {
+    std::mt19937 rng{ 42 };
+    std::uniform_int_distribution<int> dist{ 0, max };
+    std::uniform_int_distribution<size_t> option{ 0, std::size(OneOf::lookup::sorted) - 1 };
+    std::vector<int> queries(num_values);
+    for (size_t i = 0; i < queries.size(); i++) queries[i] = i % 2 ? dist(rng) : OneOf::lookup::sorted[option(rng)];
+    return queries;
+}
+
+template<typename OneOf, aut::lookup_strategy S>
+auto lookup(const std::vector<int>& queries) {
+    return [&queries] {
+        int acc = 0;
+        for (const auto q : queries) acc += OneOf::lookup::template contains<S>(q);
+        sink = acc;
+    };
+}
+
+template<typename OneOf>
+void compare(const std::string& name, int max) {
+    const auto queries = make_queries<OneOf>(max);
+    const auto s = aut::run_benchmark(name, lookup<OneOf, OneOf::lookup::strategy>(queries));
+    const auto f = aut::run_benchmark(name + "_fold", lookup<OneOf, aut::lookup_strategy::fold>(queries));
+    std::cout << s << f << "  " << name << "/fold (p50): " << s.p50 / f.p50 << "\n" << std::endl;
+    results.push_back(s);
+    results.push_back(f);
+}
+
+}
+
+int main(int argc, char** argv) {
+    compare<dense>("bitmask", 800);
+    compare<mid>("simd", 50000);
+    compare<sparse>("binary_search", 500000);
+
+    // Usage: one_of_lookup_benchmark [--json <file>]
+    if (argc == 3 && std::string{ argv[1] } == "--json") {
+        std::ofstream json{ argv[2] };
+        aut::write_json(json, results);
+    }
+}
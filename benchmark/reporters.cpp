@@ -0,0 +1,64 @@
+// Throughput of the buffered, asynchronously flushed JSON Lines reporter compared with writing each record to a file
+// stream and ending it with std::endl, which flushes the stream once per case.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "reporter.hpp"
+
+namespace {
+
+constexpr size_t num_records = 1'000'000;
+
+std::vector<aut::benchmark_result> results;
+
+aut::case_record make_record(size_t i, const std::string_view (&arguments)[2]) {
+    return { i, arguments, "42", i % 7 != 0, false, aut::case_fault::none, 0, 37.5 };
+}
+
+}
+
+int main(int argc, char** argv) {
+    aut::benchmark_options options;
+    options.samples = 5;
+    options.warmup_samples = 1;
+    options.min_sample_time = std::chrono::nanoseconds{ 0 };
+
+    const auto path = (std::filesystem::temp_directory_path() / "aut_reporters_benchmark.jsonl").string();
+    const std::string_view arguments[2] = { "-10", "0.125" };
+
+    const auto buffered = aut::run_benchmark("jsonl_reporter", [&] {
+        aut::jsonl_reporter reporter{ path };
+        reporter.begin_run({ "f", num_records, 0, 0, 0 });
+        for (size_t i = 0; i < num_records; i++) reporter.write_case(make_record(i, arguments));
+        reporter.end_run();
+    }, options);
+
+    const auto flushed = aut::run_benchmark("endl_per_record", [&] {
+        std::ofstream os{ path };
+        for (size_t i = 0; i < num_records; i++) {
+            const auto r = make_record(i, arguments);
+            os << "{\"run\":\"f\",\"case\":" << r.case_index << ",\"arguments\":[" << r.arguments[0] << ',' << r.arguments[1]
+               << "],\"output\":" << r.output << ",\"passed\":" << (r.passed ? "true" : "false")
+               << ",\"over_budget\":false,\"fault\":\"none\",\"duration_ns\":" << r.duration_ns << '}' << std::endl;
+        }
+    }, options);
+    std::filesystem::remove(path);
+
+    std::cout << buffered << flushed
+              << "  jsonl_reporter: " << buffered.p50 / num_records << " ns/record, endl per record: "
+              << flushed.p50 / num_records << " ns/record, speedup " << flushed.p50 / buffered.p50 << "x" << std::endl;
+    results.push_back(buffered);
+    results.push_back(flushed);
+
+    // Usage: reporters_benchmark [--json <file>]
+    if (argc == 3 && std::string{ argv[1] } == "--json") {
+        std::ofstream json{ argv[2] };
+        aut::write_json(json, results);
+    }
+}
@@ -0,0 +1,118 @@
+// Runtime comparison of the constraint wrappers with the equivalent operations on raw types.
+// The generated code of the same function pairs is compared by the zero_overhead_asm_check target.
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "zero_overhead_kernels.hpp"
+
+namespace {
+
+constexpr size_t num_values = 1024;
+
+volatile int sink = 0;
+
+std::vector<int> make_values() {
+    std::mt19937 rng{ 42 };
+    std::uniform_int_distribution<int> dist{ -200, 200 };
+    std::vector<int> values(num_values);
+    for (auto& v : values) v = dist(rng);
+    return values;
+}
+
+const std::vector<int> values = make_values();
+
+std::vector<aut::benchmark_result> results;
+
+template<typename Constrained, typename Raw>
+void compare(const std::string& name, Constrained&& constrained, Raw&& raw) {
+    const auto c = aut::run_benchmark("constrained_" + name, constrained);
+    const auto r = aut::run_benchmark("raw_" + name, raw);
+    std::cout << c << r << "  constrained/raw (p50): " << c.p50 / r.p50 << "\n" << std::endl;
+    results.push_back(c);
+    results.push_back(r);
+}
+
+template<typename R>
+auto unary(R(*func)(int)) {
+    return [func] {
+        int acc = 0;
+        for (const auto v : values) acc += func(v);
+        sink = acc;
+    };
+}
+
+template<typename R>
+auto binary(R(*func)(int, int)) {
+    return [func] {
+        int acc = 0;
+        for (size_t i = 1; i < values.size(); i++) acc += func(values[i - 1], values[i] | 1);
+        sink = acc;
+    };
+}
+
+}
+
+int main(int argc, char** argv) {
+    compare("add", binary(constrained_add), binary(raw_add));
+    compare("arithmetic", [] {
+        int acc = 0;
+        for (size_t i = 2; i < values.size(); i++) acc += constrained_arithmetic(values[i - 2], values[i - 1], values[i] | 1);
+        sink = acc;
+    }, [] {
+        int acc = 0;
+        for (size_t i = 2; i < values.size(); i++) acc += raw_arithmetic(values[i - 2], values[i - 1], values[i] | 1);
+        sink = acc;
+    });
+    compare("float_arithmetic", [] {
+        float acc = 0.f;
+        for (size_t i = 1; i < values.size(); i++) acc += constrained_float_arithmetic(static_cast<float>(values[i - 1]), static_cast<float>(values[i]), values[i] & 3);
+        sink = static_cast<int>(acc);
+    }, [] {
+        float acc = 0.f;
+        for (size_t i = 1; i < values.size(); i++) acc += raw_float_arithmetic(static_cast<float>(values[i - 1]), static_cast<float>(values[i]), values[i] & 3);
+        sink = static_cast<int>(acc);
+    });
+    compare("compound_assignment", binary(constrained_compound_assignment), binary(raw_compound_assignment));
+    compare("increment", unary(constrained_increment), unary(raw_increment));
+    compare("derived_return", binary(constrained_derived_return), binary(raw_derived_return));
+    compare("compare_less", binary(constrained_compare_less), binary(raw_compare_less));
+    compare("compare_equal", unary(constrained_compare_equal), unary(raw_compare_equal));
+    compare("compare_greater_eq", binary(constrained_compare_greater_eq), binary(raw_compare_greater_eq));
+
+    compare("valid_less", unary(constrained_valid_less), unary(raw_valid_less));
+    compare("valid_greater", unary(constrained_valid_greater), unary(raw_valid_greater));
+    compare("valid_less_eq", unary(constrained_valid_less_eq), unary(raw_valid_less_eq));
+    compare("valid_greater_eq", unary(constrained_valid_greater_eq), unary(raw_valid_greater_eq));
+    compare("valid_in_range", unary(constrained_valid_in_range), unary(raw_valid_in_range));
+    compare("valid_one_of", unary(constrained_valid_one_of), unary(raw_valid_one_of));
+    compare("valid_and", unary(constrained_valid_and), unary(raw_valid_and));
+    compare("valid_or", unary(constrained_valid_or), unary(raw_valid_or));
+    compare("valid_not", unary(constrained_valid_not), unary(raw_valid_not));
+    compare("valid_nested", unary(constrained_valid_nested), unary(raw_valid_nested));
+
+    compare("bubble_sort", [] {
+        std::vector<aut::in_range<0, 100, int>> arr;
+        arr.reserve(64);
+        for (int i = 64; i > 0; i--) arr.emplace_back(i);
+        constrained_bubble_sort(arr.data(), arr.size());
+        sink = arr.front();
+    }, [] {
+        std::vector<int> arr;
+        arr.reserve(64);
+        for (int i = 64; i > 0; i--) arr.emplace_back(i);
+        raw_bubble_sort(arr.data(), arr.size());
+        sink = arr.front();
+    });
+
+    // Usage: zero_overhead_benchmark [--json <file>]
+    if (argc == 3 && std::string{ argv[1] } == "--json") {
+        std::ofstream json{ argv[2] };
+        aut::write_json(json, results);
+    }
+}
@@ -0,0 +1,163 @@
+#include "zero_overhead_kernels.hpp"
+
+#include <utility>
+
+// Operands with interval arithmetic and a result type, whose constructions are checked. The interval [0, 15] of the
+// sum lies inside the result constraint, so the check is left out.
+using derived_operand = aut::in_range<0, 10>;
+using checked_result = aut::greater_eq<0>;
+
+template<>
+struct aut::interval_arithmetic_of<derived_operand> : std::true_type {};
+
+template<>
+struct aut::check_policy_of<checked_result> {
+    using type = aut::check_policy<aut::check_mode::boundary>;
+};
+
+extern "C" {
+
+int constrained_add(int a, int b) {
+    const aut::in_range<0, 10> x{ a };
+    const aut::less<100> y{ b };
+    return x + y;
+}
+int raw_add(int a, int b) {
+    return a + b;
+}
+
+int constrained_arithmetic(int a, int b, int c) {
+    const aut::in_range<0, 10> x{ a };
+    const aut::less<100> y{ b };
+    const aut::greater<0> z{ c };
+    return (x + y) * z - x / z;
+}
+int raw_arithmetic(int a, int b, int c) {
+    return (a + b) * c - a / c;
+}
+
+float constrained_float_arithmetic(aut::greater<0.f, float> n, aut::in_range<-10.f, 10.f, float> m, aut::one_of<1, 2, -1, 3> o) {
+    return n * m * static_cast<float>(o);
+}
+float raw_float_arithmetic(float n, float m, int o) {
+    return n * m * static_cast<float>(o);
+}
+
+int constrained_compound_assignment(int a, int b) {
+    aut::in_range<0, 10> x{ a };
+    const aut::less<100> y{ b };
+    x += y;
+    x *= y;
+    x -= 3;
+    x /= y;
+    return x;
+}
+int raw_compound_assignment(int a, int b) {
+    int x = a;
+    x += b;
+    x *= b;
+    x -= 3;
+    x /= b;
+    return x;
+}
+
+int constrained_increment(int a) {
+    aut::in_range<0, 10> x{ a };
+    ++x;
+    const aut::in_range<0, 10> y = x++;
+    --x;
+    return x-- + y;
+}
+int raw_increment(int a) {
+    int x = a;
+    ++x;
+    const int y = x++;
+    --x;
+    return x-- + y;
+}
+
+int constrained_derived_return(int a, int b) {
+    const derived_operand x{ aut::unchecked, a };
+    const aut::in_range<0, 5> y{ aut::unchecked, b };
+    const checked_result r = x + y;
+    return r;
+}
+int raw_derived_return(int a, int b) {
+    return a + b;
+}
+
+bool constrained_compare_less(int a, int b) {
+    const aut::less<10> x{ a };
+    const aut::in_range<0, 5> y{ b };
+    return x < y;
+}
+bool raw_compare_less(int a, int b) {
+    return a < b;
+}
+bool constrained_compare_equal(int a) {
+    return aut::less<10>{ a } == 3;
+}
+bool raw_compare_equal(int a) {
+    return a == 3;
+}
+bool constrained_compare_greater_eq(int a, int b) {
+    const aut::less<10> x{ a };
+    const aut::in_range<0, 5> y{ b };
+    return y >= x;
+}
+bool raw_compare_greater_eq(int a, int b) {
+    return b >= a;
+}
+
+bool constrained_valid_less(int v) { return aut::less<10>{ v }.is_valid(); }
+bool raw_valid_less(int v) { return v < 10; }
+bool constrained_valid_greater(int v) { return aut::greater<10>{ v }.is_valid(); }
+bool raw_valid_greater(int v) { return v > 10; }
+bool constrained_valid_less_eq(int v) { return aut::less_eq<10>{ v }.is_valid(); }
+bool raw_valid_less_eq(int v) { return v <= 10; }
+bool constrained_valid_greater_eq(int v) { return aut::greater_eq<10>{ v }.is_valid(); }
+bool raw_valid_greater_eq(int v) { return v >= 10; }
+bool constrained_valid_in_range(int v) { return aut::in_range<-5, 10>{ v }.is_valid(); }
+bool raw_valid_in_range(int v) { return v >= -5 && v <= 10; }
+bool constrained_valid_one_of(int v) { return aut::one_of<1, 7, 3, 12>{ v }.is_valid(); }
+bool raw_valid_one_of(int v) { return v == 1 || v == 7 || v == 3 || v == 12; }
+
+bool constrained_valid_and(int v) { return aut::_and<aut::greater<0>, aut::less<100>>{ v }.is_valid(); }
+bool raw_valid_and(int v) { return v > 0 && v < 100; }
+bool constrained_valid_or(int v) { return aut::_or<aut::less<0>, aut::greater<100>>{ v }.is_valid(); }
+bool raw_valid_or(int v) { return v < 0 || v > 100; }
+bool constrained_valid_not(int v) { return aut::_not<aut::in_range<0, 100>>{ v }.is_valid(); }
+bool raw_valid_not(int v) { return !(v >= 0 && v <= 100); }
+bool constrained_valid_nested(int v) {
+    return aut::_or<aut::_and<aut::greater<0>, aut::_not<aut::one_of<5, 6>>>, aut::less_eq<-100>>{ v }.is_valid();
+}
+bool raw_valid_nested(int v) {
+    return (v > 0 && !(v == 5 || v == 6)) || v <= -100;
+}
+
+void constrained_bubble_sort(aut::in_range<0, 100, int>* arr, size_t n) {
+    for (size_t i = 0; i + 1 < n; ++i) {
+        bool swapped = false;
+        for (size_t j = 0; j + 1 < n - i; ++j) {
+            if (arr[j] > arr[j + 1]) {
+                std::swap(arr[j], arr[j + 1]);
+                swapped = true;
+            }
+        }
+        if (!swapped) break;
+    }
+}
+void raw_bubble_sort(int* arr, size_t n) {
+    for (size_t i = 0; i + 1 < n; ++i) {
+        bool swapped = false;
+        for (size_t j = 0; j + 1 < n - i; ++j) {
+            if (arr[j] > arr[j + 1]) {
+                std::swap(arr[j], arr[j + 1]);
+                swapped = true;
+            }
+        }
+        if (!swapped) break;
+    }
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+
+#include "constraints.hpp"
+#include "constraint_combiner.hpp"
+
+/*
+ * Pairs of functions which perform the same operation, once through the constraint wrappers and once on the raw type.
+ * The names follow the scheme "constrained_<name>" and "raw_<name>". compare_asm.cmake fails if the two functions of a
+ * pair compile to different instructions, except for the known differences listed there.
+ */
+extern "C" {
+
+int constrained_add(int a, int b);
+int raw_add(int a, int b);
+
+int constrained_arithmetic(int a, int b, int c);
+int raw_arithmetic(int a, int b, int c);
+
+float constrained_float_arithmetic(aut::greater<0.f, float> n, aut::in_range<-10.f, 10.f, float> m, aut::one_of<1, 2, -1, 3> o);
+float raw_float_arithmetic(float n, float m, int o);
+
+int constrained_compound_assignment(int a, int b);
+int raw_compound_assignment(int a, int b);
+
+int constrained_increment(int a);
+int raw_increment(int a);
+
+int constrained_derived_return(int a, int b);
+int raw_derived_return(int a, int b);
+
+bool constrained_compare_less(int a, int b);
+bool raw_compare_less(int a, int b);
+bool constrained_compare_equal(int a);
+bool raw_compare_equal(int a);
+bool constrained_compare_greater_eq(int a, int b);
+bool raw_compare_greater_eq(int a, int b);
+
+bool constrained_valid_less(int v);
+bool raw_valid_less(int v);
+bool constrained_valid_greater(int v);
+bool raw_valid_greater(int v);
+bool constrained_valid_less_eq(int v);
+bool raw_valid_less_eq(int v);
+bool constrained_valid_greater_eq(int v);
+bool raw_valid_greater_eq(int v);
+bool constrained_valid_in_range(int v);
+bool raw_valid_in_range(int v);
+bool constrained_valid_one_of(int v);
+bool raw_valid_one_of(int v);
+
+bool constrained_valid_and(int v);
+bool raw_valid_and(int v);
+bool constrained_valid_or(int v);
+bool raw_valid_or(int v);
+bool constrained_valid_not(int v);
+bool raw_valid_not(int v);
+bool constrained_valid_nested(int v);
+bool raw_valid_nested(int v);
+
+void constrained_bubble_sort(aut::in_range<0, 100, int>* arr, size_t n);
+void raw_bubble_sort(int* arr, size_t n);
+
+}
@@ -0,0 +1,18 @@
+// Functions under test of the coverage-guided tests. This file is compiled with -fsanitize-coverage=trace-pc, if the
+// compiler supports it, so guided_fuzz_func sees their control flow edges.
+
+#include "constraints.hpp"
+
+// Only fails if all three bytes of a match, i.e. for 1 of 2^24 values.
+aut::greater_eq<0> magic_bytes(aut::in_range<0, 0xffffff> a, aut::in_range<0, 100> b) {
+	const int x = a;
+	const int y = b;
+	if ((x & 0xff) == 0x2a) {
+		if (((x >> 8) & 0xff) == 0x17) {
+			if ((x >> 16) == 0x5c) return -y - 1;
+			return 2 * y;
+		}
+		return y + 1;
+	}
+	return y;
+}
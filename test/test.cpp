@@ -10,9 +10,30 @@
 #include "constraint_combiner.hpp"
 #include "evaluation.hpp"
 #include "testgenerator.hpp"
+#include "case_space.hpp"
+#include "domain_space.hpp"
+#include "covering_array.hpp"
 #include "helper.hpp"
+#include "parallel.hpp"
+#include "benchmark.hpp"
+#include "bulk_validation.hpp"
+#include "containers.hpp"
+#include "gtest_registration.hpp"
 
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 aut::greater<0, int> fib(aut::greater<0, int> n) {
@@ -44,6 +65,14 @@ aut::greater<0.f, float> myFunc2(
 	return n * m * static_cast<float>(o);
 }
 
+constexpr aut::greater_eq<0> constexpr_square(aut::in_range<-10, 10> a, aut::one_of<1, 2, 3> b) {
+	return a * a * b;
+}
+
+constexpr aut::greater<0> constexpr_product(aut::in_range<-10, 10> a, aut::one_of<1, 2, 3> b) {
+	return a * b;
+}
+
 float myFunc2_unconstrained(float n, float m, float o) {
 	return n * m * static_cast<float>(o);
 }
@@ -100,6 +129,59 @@ TEST(Constraints, Vector) {
 }
 
 
+template<typename OneOf, typename T>
+void expect_same_as_fold(T first, T last) {
+	for (T v = first; v <= last; v++) {
+		EXPECT_EQ(OneOf{ v }.is_valid(), OneOf::lookup::template contains<aut::lookup_strategy::fold>(v)) << v;
+	}
+}
+
+TEST(Constraints, OneOfLookup) {
+	using small = aut::one_of<0, 1, 54, 2>;
+	using dense = aut::one_of<10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 100>;
+	using mid = aut::one_of<-5000, 17, 900, 12345, 3, 77777, -1, 40000, 256, 1024, 99>;
+	using sparse = aut::one_of<
+		100, 200, 300, 400, 500, 600, 700, 800, 900, 1000, 1100, 1200, 1300, 1400, 1500, 1600, 1700, 1800, 1900, 2000,
+		2100, 2200, 2300, 2400, 2500, 2600, 2700, 2800, 2900, 3000, 3100, 3200, 3300, 3400, 3500, 3600, 3700, 3800, 3900, 4000,
+		4100, 4200, 4300, 4400, 4500, 4600, 4700, 4800, 4900, 5000, 5100, 5200, 5300, 5400, 5500, 5600, 5700, 5800, 5900, 6000,
+		6100, 6200, 6300, 6400, 6500, 6600, 6700, 6800, 6900, 7000, -7100, -5, 1>;
+	using unsigned_dense = aut::one_of<0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 4294967295u>;
+	using chars = aut::one_of<'a', 'e', 'i', 'o', 'u', 'y', 'A', 'E', 'I', 'O', 'U'>;
+	using floats = aut::one_of<1.f, 2.5f, -0.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f>;
+	using doubles = aut::one_of<1., 2.5, -0., 3., 4., 5., 6., 7., 8., 9.>;
+
+	static_assert(small::lookup::strategy == aut::lookup_strategy::fold);
+	static_assert(dense::lookup::strategy == aut::lookup_strategy::bitmask);
+	static_assert(mid::lookup::strategy == aut::lookup_strategy::simd);
+	static_assert(sparse::lookup::strategy == aut::lookup_strategy::binary_search);
+	static_assert(unsigned_dense::lookup::strategy == aut::lookup_strategy::simd);
+	static_assert(chars::lookup::strategy == aut::lookup_strategy::bitmask);
+	static_assert(floats::lookup::strategy == aut::lookup_strategy::simd);
+	static_assert(doubles::lookup::strategy == aut::lookup_strategy::binary_search);
+
+	static_assert(dense{ 100 }.is_valid() && !dense{ 101 }.is_valid());
+	static_assert(mid{ 77777 }.is_valid() && !mid{ 0 }.is_valid());
+	static_assert(sparse{ -7100 }.is_valid() && !sparse{ 150 }.is_valid());
+
+	expect_same_as_fold<small>(-100, 100);
+	expect_same_as_fold<dense>(-100, 200);
+	expect_same_as_fold<mid>(-6000, 80000);
+	expect_same_as_fold<sparse>(-8000, 8000);
+	expect_same_as_fold<chars>(char{ 0 }, char{ 126 });
+	expect_same_as_fold<unsigned_dense>(0u, 100u);
+	EXPECT_TRUE(unsigned_dense{ 4294967295u }.is_valid());
+	EXPECT_FALSE(unsigned_dense{ 4294967294u }.is_valid());
+
+	EXPECT_TRUE(floats{ 0.f }.is_valid());
+	EXPECT_TRUE(floats{ 2.5f }.is_valid());
+	EXPECT_FALSE(floats{ 2.f }.is_valid());
+	EXPECT_FALSE(floats{ std::numeric_limits<float>::quiet_NaN() }.is_valid());
+	EXPECT_TRUE(doubles{ 0. }.is_valid());
+	EXPECT_TRUE(doubles{ 9. }.is_valid());
+	EXPECT_FALSE(doubles{ 8.5 }.is_valid());
+	EXPECT_FALSE(doubles{ std::numeric_limits<double>::quiet_NaN() }.is_valid());
+}
+
 TEST(Constraints, Arithmetic) {
 
 	aut::less<100> a{ 11 };
@@ -177,6 +259,318 @@ TEST(Constraints, FunctionCall3) {
 	EXPECT_FLOAT_EQ(res, 4.f);
 }
 
+template<typename C, typename T>
+void expect_bulk_same_as_scalar(const std::vector<T>& raw) {
+	for (size_t n = 0; n <= raw.size(); n++) {
+		const std::vector<C> values(raw.begin(), raw.begin() + n);
+		size_t count = 0;
+		size_t first = n;
+		for (size_t i = 0; i < n; i++) {
+			if (values[i].is_valid()) continue;
+			count++;
+			first = std::min(first, i);
+		}
+		EXPECT_EQ(aut::count_invalid(values), count) << n;
+		EXPECT_EQ(aut::first_invalid(values), first) << n;
+		EXPECT_EQ(aut::all_valid(values), count == 0) << n;
+	}
+}
+
+TEST(Constraints, BulkValidation) {
+	std::vector<int> ints(100);
+	for (size_t i = 0; i < ints.size(); i++) ints[i] = static_cast<int>(i * 37 % 211) - 100;
+	ints[3] = std::numeric_limits<int>::lowest();
+	ints[71] = std::numeric_limits<int>::max();
+
+	expect_bulk_same_as_scalar<aut::in_range<-90, 90>>(ints);
+	expect_bulk_same_as_scalar<aut::less<50>>(ints);
+	expect_bulk_same_as_scalar<aut::greater_eq<-50>>(ints);
+	expect_bulk_same_as_scalar<aut::one_of<-100, 11, 48, 85>>(ints);
+	expect_bulk_same_as_scalar<aut::_or<aut::_and<aut::greater<0>, aut::_not<aut::one_of<5, 6>>>, aut::less_eq<-100>>>(ints);
+
+	std::vector<float> floats(100);
+	for (size_t i = 0; i < floats.size(); i++) floats[i] = static_cast<float>(ints[i]) / 8.f;
+	floats[5] = std::numeric_limits<float>::quiet_NaN();
+	floats[20] = -0.f;
+	floats[40] = std::numeric_limits<float>::infinity();
+
+	expect_bulk_same_as_scalar<aut::in_range<-10.f, 10.f>>(floats);
+	expect_bulk_same_as_scalar<aut::greater<0.f>>(floats);
+	expect_bulk_same_as_scalar<aut::_or<aut::in_range<0.f, 10.f>, aut::one_of<-12.5f, -11.f>>>(floats);
+	expect_bulk_same_as_scalar<aut::_not<aut::in_range<-1.f, 1.f>>>(floats);
+	expect_bulk_same_as_scalar<aut::_not<aut::less_eq<std::numeric_limits<float>::infinity()>>>(floats);
+
+	// Constraints without vector kernel are checked element by element.
+	expect_bulk_same_as_scalar<aut::in_range<-90., 90.>>(std::vector<double>(floats.begin(), floats.end()));
+
+	std::vector<aut::in_range<0, 100, int>> vec = { 0, 10, 4, 123 };
+	EXPECT_EQ(aut::first_invalid(std::span{ vec }.first(3)), 3);
+	EXPECT_EQ(aut::first_invalid(vec), 3);
+}
+
+using always_throwing = aut::in_range<0, 7>;
+using boundary_throwing = aut::in_range<1, 9>;
+using always_logging = aut::less<-3>;
+using aborting = aut::greater<-3>;
+
+namespace aut {
+template<>
+struct check_policy_of<always_throwing> {
+	using type = check_policy<check_mode::always, violation_action::throw_exception>;
+};
+template<>
+struct check_policy_of<boundary_throwing> {
+	using type = check_policy<check_mode::boundary, violation_action::throw_exception>;
+};
+template<>
+struct check_policy_of<always_logging> {
+	using type = check_policy<check_mode::always, violation_action::log>;
+};
+template<>
+struct check_policy_of<aborting> {
+	using type = check_policy<check_mode::boundary, violation_action::abort>;
+};
+}
+
+always_throwing increment_checked(always_throwing a) {
+	return a + 1;
+}
+
+boundary_throwing increment_boundary(boundary_throwing a) {
+	a += 1;
+	return a;
+}
+
+TEST(CheckPolicy, None) {
+	static_assert(std::is_same_v<aut::check_policy_of<aut::in_range<0, 10>>::type, aut::default_check_policy>);
+	static_assert(aut::default_check_policy::mode == aut::check_mode::none, "The tests have to be built with AUT_CHECK_MODE=none.");
+	static_assert(std::is_nothrow_constructible_v<aut::in_range<0, 10>, int>);
+	static_assert(std::is_trivially_copyable_v<aut::_and<aut::greater<0>, aut::less<10>>>);
+	static_assert(!std::is_nothrow_constructible_v<always_throwing, int>);
+
+	aut::in_range<0, 10> a{ 11 };
+	a += 5;
+	a++;
+	EXPECT_EQ(a.m_t, 17);
+	EXPECT_FALSE(a.is_valid());
+}
+
+TEST(CheckPolicy, Always) {
+	EXPECT_THROW(always_throwing{ 8 }, aut::constraint_violation);
+	EXPECT_NO_THROW(always_throwing{ 7 });
+
+	always_throwing a{ 6 };
+	EXPECT_NO_THROW(++a);
+	EXPECT_THROW(a++, aut::constraint_violation);
+	EXPECT_THROW(a = 9, aut::constraint_violation);
+	a = 0;
+	EXPECT_THROW(a -= 1, aut::constraint_violation);
+	EXPECT_THROW(a *= 10, aut::constraint_violation);
+
+	EXPECT_EQ(increment_checked(3), 4);
+	EXPECT_THROW(increment_checked(7), aut::constraint_violation);
+	EXPECT_THROW(increment_checked(-1), aut::constraint_violation);
+
+	try {
+		always_throwing{ 100 };
+	}
+	catch (const aut::constraint_violation& e) {
+		EXPECT_STREQ(e.what(), "Constraint violated: 100 (in [0, 7])");
+	}
+
+	// Probing and suspended checks.
+	EXPECT_FALSE((always_throwing{ aut::unchecked, 8 }.is_valid()));
+	EXPECT_FALSE((aut::_or<always_throwing, aut::greater<100>>{ 50 }.is_valid()));
+	{
+		const aut::suspend_checks suspended;
+		EXPECT_NO_THROW(increment_checked(7));
+	}
+	EXPECT_THROW(increment_checked(7), aut::constraint_violation);
+
+	// Compile-time evaluation is never checked.
+	static_assert(!always_throwing{ 8 }.is_valid());
+}
+
+TEST(CheckPolicy, Boundary) {
+	EXPECT_THROW(boundary_throwing{ 0 }, aut::constraint_violation);
+	EXPECT_THROW(increment_boundary(10), aut::constraint_violation);
+
+	boundary_throwing b{ 9 };
+	EXPECT_NO_THROW(b += 1);
+	EXPECT_NO_THROW(b++);
+	EXPECT_FALSE(b.is_valid());
+	// Copies of constrained values are not checked again.
+	EXPECT_EQ(increment_boundary(b), 12);
+	EXPECT_EQ(increment_boundary(8), 9);
+}
+
+TEST(CheckPolicy, Log) {
+	testing::internal::CaptureStderr();
+	always_logging a{ 0 };
+	a += 1;
+	const std::string output = testing::internal::GetCapturedStderr();
+
+	EXPECT_EQ(a.m_t, 1);
+	EXPECT_EQ(output, "Constraint violated: 0 (< -3 )\nConstraint violated: 1 (< -3 )\n");
+}
+
+TEST(CheckPolicyDeathTest, Abort) {
+	EXPECT_DEATH(aborting{ -5 }, "Constraint violated: -5");
+	aborting a{ 0 };
+	a -= 10;
+	EXPECT_EQ(a.m_t, -10);
+}
+
+using derived_lhs = aut::in_range<0, 20>;
+using derived_rhs = aut::in_range<-5, 5>;
+using derived_wide = aut::in_range<-10, 30>;
+using derived_narrow = aut::in_range<0, 24>;
+
+namespace aut {
+template<>
+struct interval_arithmetic_of<derived_lhs> : std::true_type {};
+template<>
+struct check_policy_of<derived_wide> {
+	using type = check_policy<check_mode::boundary, violation_action::throw_exception>;
+};
+template<>
+struct check_policy_of<derived_narrow> {
+	using type = check_policy<check_mode::boundary, violation_action::throw_exception>;
+};
+}
+
+auto derived_sum(derived_lhs a, derived_rhs b) {
+	return a + b;
+}
+
+derived_narrow narrow_sum(derived_lhs a, derived_rhs b) {
+	return a + b;
+}
+
+// c is not checked with check_mode::none, so the derived interval of c + b does not hold.
+aut::bounded<-5, 25> forged_sum(derived_lhs a, derived_rhs b) {
+	const derived_lhs c{ static_cast<int>(a) * 3 };
+	return c + b;
+}
+
+using derived_float = aut::in_range<0.25f, 0.75f>;
+
+template<>
+struct aut::interval_arithmetic_of<derived_float> : std::true_type {};
+
+// Bounded values can neither be made from raw values nor be narrowed or modified, so they cannot leave their interval.
+template<typename B, typename... Args>
+concept constructible_from = requires(Args... args) { B{ args... }; };
+
+template<typename B>
+concept incrementable = requires(B b) { ++b; };
+
+template<typename B>
+concept compound_assignable = requires(B b) { b += 1; };
+
+TEST(IntervalArithmetic, DerivedIntervals) {
+	const derived_lhs a{ 12 };
+	const derived_rhs b{ -3 };
+	static_assert(std::is_same_v<decltype(a + b), aut::bounded<-5, 25>>);
+	static_assert(std::is_same_v<decltype(b - a), aut::bounded<-25, 5>>);
+	static_assert(std::is_same_v<decltype(a * b), aut::bounded<-100, 100>>);
+	static_assert(std::is_same_v<decltype(a / aut::in_range<1, 4>{ 2 }), aut::bounded<0, 20>>);
+	static_assert(std::is_same_v<decltype((a + b) * aut::one_of<1, 2>{ 2 }), aut::bounded<-10, 50>>);
+	EXPECT_EQ(a + b, 9);
+	EXPECT_EQ(b - a, -15);
+	EXPECT_EQ(a * b, -36);
+	EXPECT_EQ(((a + b) * aut::one_of<1, 2>{ 2 }), 18);
+
+	// Without opt-in, with raw operands or with a divisor interval containing 0, the result stays a raw value.
+	static_assert(std::is_same_v<decltype(aut::in_range<0, 10>{ 1 } + aut::in_range<0, 5>{ 1 }), int>);
+	static_assert(std::is_same_v<decltype(a + 1), int>);
+	static_assert(std::is_same_v<decltype(a / b), int>);
+	static_assert(std::is_same_v<decltype(a + aut::in_range<0L, 5L>{ 1L }), int>);
+
+	// Results, which may overflow, are not derived.
+	using int_max = aut::bounded<0, std::numeric_limits<int>::max()>;
+	static_assert(std::is_same_v<decltype(std::declval<int_max>() + a), int>);
+	static_assert(std::is_same_v<decltype(std::declval<int_max>() - a), aut::bounded<-20, std::numeric_limits<int>::max()>>);
+	using small_unsigned = aut::bounded<0u, 10u, unsigned>;
+	static_assert(std::is_same_v<decltype(std::declval<small_unsigned>() - std::declval<small_unsigned>()), unsigned>);
+	static_assert(std::is_same_v<decltype(std::declval<small_unsigned>() * std::declval<small_unsigned>()), aut::bounded<0u, 100u, unsigned>>);
+	using large_short = aut::bounded<short{ 0 }, short{ 20000 }, short>;
+	static_assert(std::is_same_v<decltype(std::declval<large_short>() + std::declval<large_short>()), short>);
+
+	const auto unit = derived_float{ 0.5f } + derived_float{ 0.75f };
+	static_assert(std::is_same_v<std::remove_const_t<decltype(unit)>, aut::bounded<0.5f, 1.5f>>);
+	const auto f = unit * aut::in_range<-2.f, 2.f>{ 2.f };
+	static_assert(std::is_same_v<std::remove_const_t<decltype(f)>, aut::bounded<-3.f, 3.f>>);
+	EXPECT_EQ(f, 2.5f);
+	static_assert(std::is_same_v<decltype(unit / aut::in_range<-1.f, 1.f>{ 1.f }), float>);
+
+	// An infinite bound times an interval containing 0 may be NaN.
+	constexpr float inf = std::numeric_limits<float>::infinity();
+	using non_negative = aut::bounded<0.f, inf>;
+	static_assert(std::is_same_v<decltype(std::declval<non_negative>() * aut::in_range<-1.f, 1.f>{ 0.f }), float>);
+	static_assert(std::is_same_v<decltype(aut::in_range<-1.f, 1.f>{ 0.f } * std::declval<non_negative>()), float>);
+	static_assert(std::is_same_v<decltype(std::declval<aut::bounded<1.f, inf>>() * aut::in_range<0.f, 1.f>{ 0.f }), float>);
+	static_assert(std::is_same_v<decltype(std::declval<non_negative>() * derived_float{ 0.5f }), aut::bounded<0.f, inf>>);
+}
+
+TEST(IntervalArithmetic, SkippedChecks) {
+	// [-5, 25] lies inside derived_wide, so the check is left out even for an invalid operand.
+	EXPECT_NO_THROW((derived_wide{ derived_lhs{ aut::unchecked, 100 } + derived_rhs{ 0 } }));
+	const derived_wide w = derived_lhs{ aut::unchecked, 100 } + derived_rhs{ 0 };
+	EXPECT_EQ(w.m_t, 100);
+	EXPECT_THROW(derived_wide{ 100 }, aut::constraint_violation);
+
+	// [-5, 25] exceeds derived_narrow, so the value is checked.
+	EXPECT_EQ(narrow_sum(20, 4), 24);
+	EXPECT_THROW(narrow_sum(20, 5), aut::constraint_violation);
+	EXPECT_THROW(narrow_sum(0, -1), aut::constraint_violation);
+
+	// Conversions between derived intervals.
+	const aut::bounded<-10, 30> wider = derived_sum(1, 2);
+	EXPECT_EQ(wider, 3);
+
+	// A function returning bounded<0, 5> can neither narrow a + b in [-5, 25] nor wrap a raw value.
+	static_assert(!std::is_convertible_v<decltype(derived_sum(1, 2)), aut::bounded<0, 5>>);
+	static_assert(!constructible_from<aut::bounded<0, 5>, decltype(derived_sum(1, 2))>);
+	static_assert(!constructible_from<aut::bounded<0, 5>, aut::unchecked_t, int>);
+	static_assert(!constructible_from<aut::bounded<0, 5>, int>);
+	static_assert(!incrementable<aut::bounded<0, 5>>);
+	static_assert(!compound_assignable<aut::bounded<0, 5>>);
+}
+
+TEST(IntervalArithmetic, ProvenCases) {
+	const auto executed = aut::test_func{ derived_sum, {.print = false} }.report;
+	EXPECT_EQ(executed.num_proven, 0u);
+	EXPECT_EQ(executed.num_passed, 4u);
+
+	const auto proven = aut::test_func{ derived_sum, {.skip_proven = true, .print = false} }.report;
+	EXPECT_EQ(proven.num_proven, 4u);
+	EXPECT_EQ(proven.size(), 0u);
+	EXPECT_TRUE(proven.passed());
+
+	// Executing cases by default catches invalid intermediate values.
+	const auto forged = aut::test_func{ forged_sum, {.print = false} }.report;
+	EXPECT_EQ(forged.num_proven, 0u);
+	EXPECT_FALSE(forged.passed());
+
+	// Functions returning other constraints are executed.
+	const auto narrow = aut::test_func{ narrow_sum, {.print = false} }.report;
+	EXPECT_EQ(narrow.num_proven, 0u);
+	EXPECT_EQ(narrow.num_failed, 2u);
+}
+
+TEST(CheckPolicy, TestGenerator) {
+	// The generators observe invalid results instead of triggering the policy.
+	const auto lambda_func = [](always_throwing a) -> always_throwing { return a + 1; };
+
+	const auto report = aut::test_func{ lambda_func, {.print = false} }.report;
+	const auto fuzzed = aut::fuzz_func{ lambda_func, {.cases = 1000, .print = false} }.report;
+
+	EXPECT_FALSE(report.passed());
+	EXPECT_GT(fuzzed.num_failed, 0);
+	EXPECT_EQ(fuzzed.failures[0].shrunk_output, 8);
+}
+
 TEST(ConstraintCombiner, And) {
 	aut::_and<aut::in_range<0.f, 10.f>, aut::one_of<1.f, 2.f, 10.f>> b{ 10.f };
 
@@ -204,6 +598,40 @@ TEST(ConstraintCombiner, FunctionCall) {
 }
 
 
+TEST(ConstraintCombiner, Intervals) {
+	using nested = aut::_or<aut::_and<aut::greater<0>, aut::_not<aut::one_of<5, 6>>>, aut::less_eq<-100>>;
+	constexpr auto& set = aut::intervals_of<nested>::value;
+	static_assert(set.size == 3);
+	static_assert(set.intervals[0].lo == std::numeric_limits<int>::lowest() && set.intervals[0].hi == -100);
+	static_assert(set.intervals[1].lo == 1 && set.intervals[1].hi == 4);
+	static_assert(set.intervals[2].lo == 7 && set.intervals[2].hi == std::numeric_limits<int>::max());
+
+	// Consecutive options and overlapping ranges collapse into a single interval.
+	static_assert(aut::intervals_of<aut::_or<aut::one_of<3, 1, 2>, aut::in_range<4, 10>>>::value.size == 1);
+	static_assert(aut::intervals_of<aut::_and<aut::less<0>, aut::greater<0>>>::value.size == 0);
+	static_assert(aut::intervals_of<aut::_not<aut::less<std::numeric_limits<int>::lowest()>>>::value.size == 1);
+
+	for (int v = -200; v <= 200; v++) {
+		EXPECT_EQ(nested{ v }.is_valid(), (v > 0 && !(v == 5 || v == 6)) || v <= -100) << v;
+		EXPECT_EQ((aut::_not<aut::in_range<-10, 10>>{ v }.is_valid()), v < -10 || v > 10) << v;
+	}
+
+	constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+	constexpr float inf = std::numeric_limits<float>::infinity();
+	using range = aut::_or<aut::in_range<0.f, 10.f>, aut::one_of<100.f, 200.f>>;
+	EXPECT_TRUE(range{ -0.f }.is_valid());
+	EXPECT_FALSE(range{ nan }.is_valid());
+	EXPECT_TRUE(aut::_not<range>{ nan }.is_valid());
+	EXPECT_TRUE(aut::_not<range>{ -inf }.is_valid());
+	EXPECT_TRUE(aut::_not<range>{ std::nextafter(10.f, 11.f) }.is_valid());
+	EXPECT_FALSE(aut::_not<range>{ 10.f }.is_valid());
+	EXPECT_FALSE((aut::_and<aut::less<0.f>, aut::greater_eq<-0.f>>{ 0.f }.is_valid()));
+	EXPECT_TRUE((aut::_not<aut::_and<aut::less<0.f>, aut::greater<-1.f>>>{ -0.f }.is_valid()));
+	EXPECT_FALSE((aut::_not<aut::_and<aut::less<0.f>, aut::greater<-1.f>>>{ -std::numeric_limits<float>::denorm_min() }.is_valid()));
+	EXPECT_FALSE((aut::_and<aut::less_eq<inf>, aut::greater_eq<-inf>>{ nan }.is_valid()));
+	EXPECT_TRUE((aut::_and<aut::less_eq<inf>, aut::greater_eq<-inf>>{ inf }.is_valid()));
+}
+
 TEST(Evaluation, Basic) {
 	{
 		aut::less<1> a{ 16 };
@@ -231,18 +659,116 @@ TEST(Evaluation, Combiner) {
 	{
 		aut::_and<aut::greater<1>, aut::one_of<-1, 1, 5, 3>> b{ 16 };
 		constexpr auto bv = aut::evaluate<decltype(b)>::valid_border_values;
-		std::array<int, 2> exp = { 5, 3 };
+		std::array<int, 2> exp = { 3, 5 };
 		EXPECT_EQ(bv, exp);
 	}
 
 	{
 		aut::_or<aut::greater<1>, aut::one_of<-1, 1, 2, 5, 3>> b{ 16 };
 		constexpr auto bv = aut::evaluate<decltype(b)>::valid_border_values;
-		std::array<int, 5> exp = { 2, -1, 1, 5, 3 };
+		std::array<int, 5> exp = { -1, 1, 2, 3, 5 };
 		EXPECT_EQ(bv, exp);
 	}
 }
 
+TEST(Evaluation, Not) {
+	{
+		constexpr auto bv = aut::evaluate<aut::_not<aut::in_range<0, 10>>>::valid_border_values;
+		std::array<int, 2> exp = { -1, 11 };
+		EXPECT_EQ(bv, exp);
+	}
+
+	{
+		using nested = aut::_and<aut::greater<0>, aut::_not<aut::one_of<5, 6>>>;
+		constexpr auto bv = aut::evaluate<nested>::valid_border_values;
+		std::array<int, 3> exp = { 1, 4, 7 };
+		EXPECT_EQ(bv, exp);
+	}
+
+	{
+		constexpr auto bv = aut::evaluate<aut::_not<aut::less<0.f>>>::valid_border_values;
+		ASSERT_EQ(bv.size(), 1);
+		EXPECT_EQ(bv[0], 0.f);
+	}
+}
+
+TEST(CaseSpace, RandomAccess) {
+	using space = aut::case_space<aut::in_range<0, 10>, aut::one_of<1, 2, -1>, const aut::less<5>&>;
+	static_assert(space::size == 6);
+	static_assert(space::at(0) == std::make_tuple(0, 1, 4));
+	static_assert(space::at(5) == std::make_tuple(10, -1, 4));
+
+	EXPECT_EQ(space::at(1), std::make_tuple(0, 2, 4));
+	EXPECT_EQ(space{}[3], std::make_tuple(10, 1, 4));
+	EXPECT_EQ(space::digits(4), (std::array<size_t, 3>{ 1, 1, 0 }));
+}
+
+static bool covers_all_interactions(const std::vector<size_t>& radices, size_t t, const std::vector<size_t>& rows) {
+	const size_t n = radices.size();
+	for (const auto& c : aut::detail::argument_combinations(n, t)) {
+		size_t num_tuples = 1;
+		for (const auto a : c) num_tuples *= radices[a];
+
+		std::vector<bool> seen(num_tuples, false);
+		for (auto row : rows) {
+			std::vector<size_t> digits(n);
+			for (size_t i = n; i-- > 0;) {
+				digits[i] = row % radices[i];
+				row /= radices[i];
+			}
+			size_t index = 0;
+			for (const auto a : c) index = index * radices[a] + digits[a];
+			seen[index] = true;
+		}
+		if (std::find(seen.begin(), seen.end(), false) != seen.end()) return false;
+	}
+	return true;
+}
+
+TEST(RandomSpace, Domain) {
+	using space = aut::random_space<aut::in_range<-5, 5>, aut::_not<aut::in_range<0.f, 10.f>>, const aut::one_of<1, 3, 1000>&>;
+
+	for (size_t i = 0; i < 10000; i++) {
+		const auto [a, b, c] = space::at(42, i, 0.1);
+		EXPECT_TRUE((aut::in_range<-5, 5>{ a }.is_valid())) << a;
+		EXPECT_TRUE((aut::_not<aut::in_range<0.f, 10.f>>{ b }.is_valid())) << b;
+		EXPECT_TRUE((aut::one_of<1, 3, 1000>{ c }.is_valid())) << c;
+		EXPECT_EQ(a, std::get<0>(space::at(42, i, 0.1)));
+	}
+
+	// With a boundary bias of 1, every value is one of the 4 values next to a border.
+	for (size_t i = 0; i < 1000; i++) {
+		const int a = std::get<0>(aut::random_space<aut::greater_eq<100>>::at(7, i, 1.));
+		EXPECT_GE(a, 100);
+		EXPECT_LT(a, 104);
+	}
+}
+
+TEST(CoveringArray, Pairwise) {
+	const std::vector<size_t> radices = { 3, 3, 3, 3, 2, 4 };
+	const auto rows = aut::covering_array(radices, 2);
+
+	EXPECT_TRUE(covers_all_interactions(radices, 2, rows));
+	EXPECT_LT(rows.size(), 30);
+}
+
+TEST(CoveringArray, ThreeWise) {
+	const std::vector<size_t> radices = { 3, 2, 3, 4, 2, 3 };
+	const auto rows = aut::covering_array(radices, 3);
+
+	EXPECT_TRUE(covers_all_interactions(radices, 3, rows));
+	EXPECT_LT(rows.size(), 1296 / 4);
+}
+
+TEST(CoveringArray, CompileTime) {
+	using space = aut::case_space<aut::in_range<0, 10>, aut::one_of<1, 2, -1, 3>, aut::one_of<5, 6, 7>, aut::in_range<-1, 1>>;
+	using pairwise = aut::covering_array_of<space, aut::coverage::pairwise>;
+	static_assert(pairwise::size < space::size);
+	static_assert(aut::covering_array_of<space, aut::coverage::exhaustive>::size == space::size);
+
+	EXPECT_TRUE(covers_all_interactions({ 2, 4, 3, 2 }, 2, { pairwise::indices.begin(), pairwise::indices.end() }));
+}
+
 
 TEST(TestGenerator, GlobalFunction) {
 	aut::test_func{myFunc};
@@ -252,6 +778,119 @@ TEST(TestGenerator, GlobalFunction2) {
 	aut::test_func{myFunc2, true};
 }
 
+TEST(TestGenerator, NegatedArgument) {
+	const auto lambda_func = [](aut::_not<aut::in_range<-10, 10>> a) -> aut::_not<aut::one_of<0>> {
+		return a / 11;
+	};
+
+	const auto report = aut::test_func{ lambda_func, {.print = false} }.report;
+	EXPECT_EQ(report.size(), 2);
+	EXPECT_TRUE(report.passed());
+}
+
+TEST(TestGenerator, Fuzz) {
+	// Fails only in the inside of the domain, which the border values never reach.
+	const auto lambda_func = [](aut::in_range<0, 1000> a, aut::one_of<1, 2> b) -> aut::greater_eq<0> {
+		return a >= 600 && a <= 700 ? -b : a * b;
+	};
+
+	const auto serial = aut::fuzz_func{ lambda_func, {.cases = 100000, .print = false} }.report;
+	const auto parallel = aut::fuzz_func{ lambda_func, {.cases = 100000, .threads = 4, .batch_size = 1000, .print = false} }.report;
+
+	EXPECT_TRUE((aut::test_func{ lambda_func, {.print = false} }.report.passed()));
+	EXPECT_EQ(serial.size(), 100000);
+	EXPECT_GT(serial.num_failed, 0);
+	EXPECT_EQ(serial.num_passed + serial.num_failed, serial.size());
+	EXPECT_EQ(serial.num_failed, parallel.num_failed);
+	ASSERT_EQ(serial.failures.size(), 10);
+	ASSERT_EQ(parallel.failures.size(), 10);
+
+	for (size_t i = 0; i < serial.failures.size(); i++) {
+		const auto& f = serial.failures[i];
+		EXPECT_EQ(f.case_index, parallel.failures[i].case_index);
+		EXPECT_EQ(f.arguments, serial.arguments(f.case_index));
+		EXPECT_LT(f.output, 0);
+
+		// Shrinking stops at the border of the failing region.
+		const int shrunk = std::get<0>(f.shrunk_arguments);
+		EXPECT_TRUE(shrunk == 600 || shrunk == 700) << shrunk;
+		EXPECT_EQ(std::get<1>(f.shrunk_arguments), std::get<1>(f.arguments));
+		EXPECT_LT(f.shrunk_output, 0);
+	}
+
+	const auto other_seed = aut::fuzz_func{ lambda_func, {.seed = 1, .cases = 100000, .print = false} }.report;
+	EXPECT_NE(other_seed.failures[0].case_index, serial.failures[0].case_index);
+}
+
+TEST(TestGenerator, Parallel) {
+	const auto lambda_func = [](aut::in_range<-10, 10> a, aut::one_of<1, 2, -1, 3> b, aut::less<5> c) -> aut::greater_eq<0> {
+		return a * b * c;
+	};
+
+	const auto serial = aut::test_func{ lambda_func, {.print = false} }.report;
+	const auto parallel = aut::test_func{ lambda_func, {.threads = 4, .print = false} }.report;
+
+	EXPECT_EQ(serial.results, parallel.results);
+	EXPECT_EQ(serial.num_failed, parallel.num_failed);
+}
+
+TEST(TestGenerator, Report) {
+	const auto lambda_func = [](aut::in_range<-10, 10> a, aut::one_of<1, 2, -1, 3> b) -> aut::greater_eq<0> {
+		return a * b;
+	};
+
+	testing::internal::CaptureStdout();
+	const auto report = aut::test_func{ lambda_func }.report;
+	const std::string output = testing::internal::GetCapturedStdout();
+
+	EXPECT_EQ(report.size(), 8);
+	EXPECT_EQ(report.num_passed, 4);
+	EXPECT_EQ(report.num_failed, 4);
+	EXPECT_FALSE(report.passed());
+
+	const auto failures = report.failures();
+	ASSERT_EQ(failures.size(), 4);
+	EXPECT_EQ(failures[0].arguments, std::make_tuple(-10, 1));
+	EXPECT_EQ(failures[0].output, -10);
+	EXPECT_EQ(failures[3].arguments, std::make_tuple(10, -1));
+	EXPECT_EQ(failures[3].output, -10);
+
+	EXPECT_NE(output.find("FAILED, input = (-10, 1), output = -10 (>= 0 )"), std::string::npos) << output;
+	EXPECT_NE(output.find("8 tests, 4 passed, 4 failed"), std::string::npos) << output;
+}
+
+TEST(Parallel, ParallelFor) {
+	std::vector<std::atomic<int>> visits(1000);
+	aut::detail::parallel_for(visits.size(), 4, [&](size_t begin, size_t end, size_t) {
+		for (size_t i = begin; i < end; i++) visits[i]++;
+	});
+
+	for (const auto& v : visits) EXPECT_EQ(v, 1);
+}
+
+TEST(TestGenerator, Pairwise) {
+	const auto lambda_func = [](aut::in_range<-10, 10> a, aut::one_of<1, 2, -1, 3> b, aut::one_of<0, 1, 2> c, aut::less<5> d) -> aut::greater_eq<0> {
+		return a * a * b * b + c * d;
+	};
+
+	testing::internal::CaptureStdout();
+	const auto report = aut::test_func{ lambda_func, {.coverage = aut::coverage::pairwise} }.report;
+	const std::string output = testing::internal::GetCapturedStdout();
+
+	EXPECT_EQ(output.rfind("Generating 12 tests! (pairwise coverage of 24 cases", 0), 0) << output;
+	EXPECT_EQ(report.size(), 12);
+}
+
+TEST(TestGenerator, StaticTest) {
+	aut::static_test_func<constexpr_square>{};
+	aut::static_test_func<[](aut::in_range<0, 10> a) constexpr -> aut::greater_eq<0> { return a - 0; }>{};
+
+	// Constructing aut::static_test_func<constexpr_product> would not compile, so only inspect the result.
+	using failing = aut::static_test_func<constexpr_product>;
+	static_assert(!failing::passed);
+	static_assert(failing::space::at(failing::first_failure) == std::make_tuple(-10, 1));
+}
+
 TEST(TestGenerator, LambdaFunction) {
 	const auto lambda_func = [](aut::in_range<0, 10> a) -> aut::greater_eq<0> {
 		return (int)a;
@@ -278,6 +917,566 @@ TEST(TestGenerator, StaticMemberFunction) {
 	aut::test_func{ TestClass::static_member_func};
 }
 
+TEST(TestGenerator, LatencyProfile) {
+	// Linear in n, so the last option is a latency cliff.
+	using n_type = aut::one_of<1, 2, 3, 4, 5, 6, 7, 200000>;
+	const auto lambda_func = [](n_type n) -> aut::greater<0> {
+		volatile int sum = 0;
+		for (int i = 0; i < n; i++) sum = sum + 1;
+		return static_cast<int>(sum);
+	};
+
+	EXPECT_TRUE((aut::test_func{ lambda_func, {.print = false} }.report.profile.empty()));
+
+	const auto report = aut::test_func{ lambda_func, {.profile_repetitions = 3, .slowest_cases = 2, .print = false} }.report;
+	const auto& profile = report.profile;
+	ASSERT_EQ(profile.latencies.size(), 8);
+	EXPECT_EQ(profile.repetitions, 3);
+	EXPECT_EQ(std::accumulate(profile.histogram.begin(), profile.histogram.end(), size_t{ 0 }), 8);
+	EXPECT_LE(profile.p50, profile.p90);
+	EXPECT_LE(profile.p99, profile.max);
+
+	ASSERT_EQ(profile.slowest.size(), 2);
+	EXPECT_EQ(std::get<0>(aut::case_space<n_type>::at(report.results[profile.slowest[0]].case_index)), 200000);
+	EXPECT_EQ(profile.max, profile.latencies[profile.slowest[0]]);
+	// Other cases may be slow as well, e.g. if the thread was preempted, so only the cliff is checked.
+	EXPECT_NE(std::find(profile.slow.begin(), profile.slow.end(), profile.slowest[0]), profile.slow.end());
+
+	std::ostringstream os;
+	report.print(os);
+	const size_t slow_list = os.str().find("cases slower than 4x the median:\n");
+	ASSERT_NE(slow_list, std::string::npos) << os.str();
+	EXPECT_NE(os.str().find("input = (200000)", slow_list), std::string::npos) << os.str();
+}
+
+// 2M loop iterations take milliseconds, far beyond the budget of 20 us.
+aut::max_latency_ns<20'000, aut::greater<0>> budgeted_loop(aut::one_of<1, 2, 2'000'000> n) {
+	volatile int sum = 0;
+	for (int i = 0; i < n; i++) sum = sum + 1;
+	return static_cast<int>(sum);
+}
+
+TEST(TestGenerator, LatencyBudget) {
+	using ret_type = aut::max_latency_ns<20'000, aut::greater<0>>;
+	static_assert(aut::is_constrained<ret_type>);
+	static_assert(aut::detail::latency_budget_of<ret_type> == 20'000);
+	static_assert(aut::detail::latency_budget_of<aut::greater<0>> == 0);
+	EXPECT_TRUE(ret_type{ 1 }.is_valid());
+	EXPECT_FALSE(ret_type{ 0 }.is_valid());
+
+	const auto report = aut::test_func{ budgeted_loop, {.print = false} }.report;
+	EXPECT_EQ(report.profile.repetitions, 5);
+	EXPECT_EQ(report.num_passed, 2);
+	ASSERT_EQ(report.num_failed, 1);
+
+	const auto failures = report.failures();
+	EXPECT_EQ(std::get<0>(failures[0].arguments), 2'000'000);
+	EXPECT_EQ(failures[0].output, 2'000'000);
+	EXPECT_TRUE(failures[0].over_budget);
+
+	std::ostringstream os;
+	report.print(os);
+	EXPECT_NE(os.str().find("ns (budget 20000 ns)"), std::string::npos) << os.str();
+
+	// Invalid return values still fail within the budget.
+	const auto lambda_func = [](aut::in_range<-1, 1> a) -> aut::max_latency_ns<1'000'000, aut::greater<0>> { return static_cast<int>(a); };
+	const auto invalid = aut::test_func{ lambda_func, {.budget_repetitions = 2, .print = false} }.report;
+	EXPECT_EQ(invalid.profile.repetitions, 2);
+	EXPECT_GT(invalid.num_failed, 0);
+	for (const auto& f : invalid.failures()) EXPECT_FALSE(f.over_budget);
+}
+
+aut::greater_eq<0> square_product(aut::in_range<-10, 10> a, aut::one_of<1, 2> b) {
+	return a * a * b;
+}
+
+aut::greater_eq<0> throw_on_last(aut::in_range<-10, 10> a, aut::one_of<1, 2> b) {
+	if (a == 10 && b == 2) throw std::runtime_error{ "last case" };
+	return a * a * b;
+}
+
+aut::greater_eq<0> crash_or_hang(aut::in_range<-10, 10> a, aut::one_of<1, 2> b) {
+	if (a == -10 && b == 2) std::raise(SIGSEGV);
+	if (a == 10 && b == 1) {
+		for (;;) std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+	}
+	return a * a * b;
+}
+
+TEST(TestGenerator, Isolated) {
+#ifdef AUT_HAS_FORK
+	const auto report = aut::test_func{ crash_or_hang, {.threads = 2, .isolate = true, .case_timeout = std::chrono::milliseconds{ 200 },
+	                                                    .isolation_batch_size = 3, .print = false} }.report;
+	const auto reference = aut::test_func{ square_product, {.print = false} }.report;
+
+	ASSERT_EQ(report.size(), reference.size());
+	EXPECT_EQ(report.num_failed, 2);
+	EXPECT_EQ(report.num_passed, report.size() - 2);
+	for (size_t i = 0; i < report.size(); i++) {
+		const auto& r = report.results[i];
+		const auto [a, b] = aut::case_space<aut::in_range<-10, 10>, aut::one_of<1, 2>>::at(r.case_index);
+		EXPECT_EQ(r.case_index, reference.results[i].case_index);
+		if (a == -10 && b == 2) {
+			EXPECT_EQ(r.fault, aut::case_fault::crash);
+			EXPECT_EQ(r.signal, SIGSEGV);
+		}
+		else if (a == 10 && b == 1) {
+			EXPECT_EQ(r.fault, aut::case_fault::timeout);
+		}
+		else {
+			EXPECT_EQ(r, reference.results[i]);
+		}
+	}
+
+	std::ostringstream os;
+	report.print(os);
+	EXPECT_NE(os.str().find("FAILED, input = (-10, 2), crashed (signal " + std::to_string(SIGSEGV) + ")"), std::string::npos) << os.str();
+	EXPECT_NE(os.str().find("FAILED, input = (10, 1), timed out"), std::string::npos) << os.str();
+
+	// An exception ends the worker instead of unwinding into the forked copy of the caller.
+	const auto thrown = aut::test_func{ throw_on_last, {.threads = 2, .isolate = true, .print = false} }.report;
+	ASSERT_EQ(thrown.size(), reference.size());
+	EXPECT_EQ(thrown.num_failed, 1);
+	for (size_t i = 0; i < thrown.size(); i++) {
+		const auto [a, b] = aut::case_space<aut::in_range<-10, 10>, aut::one_of<1, 2>>::at(thrown.results[i].case_index);
+		if (a == 10 && b == 2) EXPECT_EQ(thrown.results[i].fault, aut::case_fault::exception);
+		else EXPECT_EQ(thrown.results[i], reference.results[i]);
+	}
+	std::ostringstream thrown_os;
+	thrown.print(thrown_os);
+	EXPECT_NE(thrown_os.str().find("FAILED, input = (10, 2), threw an exception"), std::string::npos) << thrown_os.str();
+
+	// Profiled isolated runs keep the latencies of the worker processes.
+	const auto profiled = aut::test_func{ square_product, {.profile_repetitions = 2, .isolate = true, .print = false} }.report;
+	EXPECT_TRUE(profiled.passed());
+	EXPECT_GT(profiled.profile.max, 0.);
+#else
+	GTEST_SKIP() << "Isolated runs need fork()";
+#endif
+}
+
+static size_t count_occurrences(const std::string& text, const std::string& pattern) {
+	size_t n = 0;
+	for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) n++;
+	return n;
+}
+
+TEST(TestGenerator, Reporters) {
+	std::ostringstream junit_os;
+	std::ostringstream jsonl_os;
+	aut::test_report<aut::case_space<aut::in_range<-10, 10>, aut::one_of<1, 2>>, aut::greater_eq<0>> report;
+	{
+		// A small buffer makes the background thread write several times.
+		aut::junit_reporter junit{ junit_os, 256 };
+		aut::jsonl_reporter jsonl{ jsonl_os, 256 };
+		report = aut::test_func{ square_product, {.name = "square<product>", .reporters = { &junit, &jsonl }, .print = false} }.report;
+	}
+
+	// Each case is timed once for the records, but the report does not get a latency profile.
+	EXPECT_TRUE(report.profile.empty());
+	EXPECT_EQ(count_occurrences(jsonl_os.str(), "\"duration_ns\":0}"), 0u) << jsonl_os.str();
+	std::ostringstream printed;
+	report.print(printed);
+	EXPECT_EQ(printed.str().find("Latency"), std::string::npos) << printed.str();
+
+	const std::string lines = jsonl_os.str();
+	EXPECT_EQ(count_occurrences(lines, "\n"), report.size());
+	EXPECT_EQ(count_occurrences(lines, "\"passed\":true"), report.num_passed);
+	EXPECT_EQ(lines.rfind("{\"run\":\"square<product>\",\"case\":", 0), 0u) << lines;
+	const auto& first = report.results.front();
+	const auto [a, b] = aut::case_space<aut::in_range<-10, 10>, aut::one_of<1, 2>>::at(first.case_index);
+	const std::string expected = "{\"run\":\"square<product>\",\"case\":" + std::to_string(first.case_index) + ",\"arguments\":[" +
+		std::to_string(a) + "," + std::to_string(b) + "],\"output\":" + std::to_string(first.output) + ",\"passed\":true";
+	EXPECT_EQ(lines.substr(0, expected.size()), expected);
+
+	const std::string xml = junit_os.str();
+	EXPECT_EQ(xml.rfind("<?xml", 0), 0u);
+	EXPECT_NE(xml.find("<testsuite name=\"square&lt;product&gt;\" tests=\"" + std::to_string(report.size()) + "\" failures=\"0\""),
+		std::string::npos) << xml;
+	EXPECT_EQ(count_occurrences(xml, "<testcase "), report.size());
+	EXPECT_EQ(count_occurrences(xml, "<failure "), report.num_failed);
+	EXPECT_EQ(xml.substr(xml.size() - 14), "</testsuites>\n");
+
+	// Failures carry the returned value.
+	std::ostringstream failing_os;
+	{
+		aut::junit_reporter junit{ failing_os };
+		aut::test_func{ myFunc2, {.reporters = { &junit }, .print = false} };
+	}
+	EXPECT_GT(count_occurrences(failing_os.str(), "<failure message=\"output = "), 0u) << failing_os.str();
+}
+
+// BubbleSort computes n - 1 on the unsigned size, so it must not be called with an empty vector.
+aut::one_of<1> BubbleSortSorts(std::vector<aut::in_range<0, 100, int>>& arr) {
+	if (arr.empty()) return 1;
+	if (!aut::all_valid(arr)) return 0;
+	BubbleSort(arr);
+	return std::is_sorted(arr.begin(), arr.end()) ? 1 : 0;
+}
+
+// Only a single pass of bubble sort, which does not sort most inputs.
+aut::one_of<1> OnePassSorts(std::vector<aut::in_range<0, 100, int>>& arr) {
+	for (size_t j = 1; j < arr.size(); ++j) {
+		if (arr[j - 1] > arr[j]) std::swap(arr[j - 1], arr[j]);
+	}
+	return std::is_sorted(arr.begin(), arr.end()) ? 1 : 0;
+}
+
+aut::greater_eq<0> SpanSum(std::span<const aut::in_range<-5, 5, int>> values) {
+	int sum = 0;
+	for (const auto v : values) sum += v.is_valid() ? v + 5 : -1000;
+	return sum;
+}
+
+aut::greater_eq<1> ArrayMin(const std::array<aut::one_of<1, 2, 3>, 4>& values, aut::in_range<0, 1> offset) {
+	return *std::min_element(values.begin(), values.end()) + offset;
+}
+
+TEST(TestGenerator, ContainerArguments) {
+	using vector_type = std::vector<aut::in_range<0, 100, int>>;
+	// Sizes 0, 1, 2 and 16 with constant, alternating, interior, ascending and descending contents.
+	EXPECT_EQ(std::size(aut::evaluate<vector_type>::valid_border_values), 16u);
+
+	const auto sorted = aut::test_func{ BubbleSortSorts, {.print = false} }.report;
+	EXPECT_EQ(sorted.size(), 16u);
+	EXPECT_EQ(sorted.num_failed, 0u);
+
+	const auto one_pass = aut::test_func{ OnePassSorts, {.threads = 2, .print = false} }.report;
+	const auto failures = one_pass.failures();
+	ASSERT_FALSE(failures.empty());
+	const auto descending = std::find_if(failures.begin(), failures.end(), [](const auto& f) {
+		return std::get<0>(f.arguments).pattern == aut::fill_pattern::descending;
+	});
+	ASSERT_NE(descending, failures.end());
+	EXPECT_EQ(std::get<0>(descending->arguments).size, 16u);
+	std::ostringstream os;
+	os << std::get<0>(descending->arguments);
+	EXPECT_EQ(os.str(), "[16, descending]");
+	for (const auto& f : failures) EXPECT_GT(std::get<0>(f.arguments).size, 2u);
+
+	// Contents are derived from the descriptor alone.
+	const auto again = aut::test_func{ OnePassSorts, {.print = false} }.report;
+	EXPECT_EQ(again.num_failed, one_pass.num_failed);
+
+	EXPECT_EQ((aut::test_func{ SpanSum, {.print = false} }.report.num_failed), 0u);
+	EXPECT_EQ((aut::fuzz_func{ SpanSum, {.seed = 7, .cases = 1000, .print = false} }.report.num_failed), 0u);
+
+	// A std::array has a fixed size: 3 constant fills and 4 other patterns.
+	const auto array = aut::test_func{ ArrayMin, {.print = false} }.report;
+	EXPECT_EQ(array.size(), 7u * 2u);
+	EXPECT_EQ(array.num_failed, 0u);
+}
+
+TEST(TestGenerator, CaseArena) {
+	aut::detail::case_arena arena{ 64 };
+	const auto allocate_case = [&] {
+		for (size_t i = 0; i < 8; i++) {
+			// Alignments above the one of operator new as well.
+			const size_t alignment = i % 2 == 0 ? 16 : 64;
+			void* p = arena.allocate(100, alignment);
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+		}
+	};
+	allocate_case();
+	const size_t blocks = arena.block_allocations();
+	EXPECT_GT(blocks, 1u);
+	// The blocks are merged, so the next cases of the same size allocate nothing.
+	for (int i = 0; i < 3; i++) {
+		arena.reset();
+		allocate_case();
+	}
+	EXPECT_EQ(arena.block_allocations(), blocks + 1);
+
+	aut::test_func{ SpanSum, {.print = false} };
+	const size_t thread_blocks = aut::detail::thread_arena().block_allocations();
+	aut::test_func{ SpanSum, {.print = false} };
+	EXPECT_EQ(aut::detail::thread_arena().block_allocations(), thread_blocks);
+}
+
+aut::greater<0.f, float> myFunc2_nudged(
+	aut::greater<0.f, float> n,
+	aut::in_range<-10.f, 10.f, float> m,
+	aut::one_of<1, 2, -1, 3> o) {
+	return n * m * static_cast<float>(o) + 1e-5f;
+}
+
+TEST(TestGenerator, DifferentialTest) {
+	const auto same = aut::diff_test_func{ myFunc2, myFunc2_unconstrained, {.print = false} }.report;
+	using space = aut::case_space_of<std::tuple<aut::greater<0.f, float>, aut::in_range<-10.f, 10.f, float>, aut::one_of<1, 2, -1, 3>>>;
+	EXPECT_EQ(same.size(), space::size);
+	EXPECT_TRUE(same.passed());
+	EXPECT_EQ(same.num_passed, space::size);
+	EXPECT_EQ(same.repetitions, 5u);
+	EXPECT_EQ(same.fastest.size(), 3u);
+	EXPECT_EQ(same.slowest.size(), 3u);
+	EXPECT_LE(same.min_ratio, same.geomean_ratio);
+	EXPECT_LE(same.geomean_ratio, same.max_ratio);
+	EXPECT_LE(same.num_faster, same.size());
+	EXPECT_LE(same.results[same.fastest.front()].ratio(), same.results[same.slowest.front()].ratio());
+	for (const auto& r : same.results) EXPECT_GT(r.reference_ns, 0.);
+
+	// Differences below the tolerance are equal.
+	EXPECT_TRUE((aut::diff_test_func{ myFunc2_nudged, myFunc2_unconstrained, {.repetitions = 0, .print = false} }.report.passed()));
+	const auto strict = aut::diff_test_func{ myFunc2_nudged, myFunc2_unconstrained, {.tolerance = 1e-7, .repetitions = 0, .print = false} }.report;
+	EXPECT_FALSE(strict.passed());
+	EXPECT_EQ(strict.results.front().candidate_ns, 0.);
+
+	// Integer outputs have to be equal. The reference only differs for negative a.
+	auto reference = [](int a, int b) { return a * (a < 0 ? -a : a) * b; };
+	const auto diff = aut::diff_test_func{ constexpr_square, reference, {.threads = 2, .print = false} }.report;
+	size_t negative = 0;
+	for (const auto& r : diff.results) {
+		if (std::get<0>(aut::case_space<aut::in_range<-10, 10>, aut::one_of<1, 2, 3>>::at(r.case_index)) < 0) negative++;
+	}
+	EXPECT_GT(negative, 0u);
+	EXPECT_EQ(diff.num_failed, negative);
+	for (const auto& m : diff.mismatches()) {
+		EXPECT_LT(std::get<0>(m.arguments), 0);
+		EXPECT_EQ(m.candidate_output, -m.reference_output);
+	}
+
+	std::ostringstream os;
+	os << diff;
+	EXPECT_NE(os.str().find("FAILED, input = (-10, 1), candidate = 100, reference = -100"), std::string::npos) << os.str();
+	EXPECT_NE(os.str().find("Largest speedups:"), std::string::npos);
+}
+
+TEST(TestGenerator, CaseRange) {
+	const auto all = aut::test_func{ square_product, {.print = false} }.report;
+	const auto part = aut::test_func{ square_product, {.first_case = 1, .num_cases = 2, .print = false} }.report;
+	ASSERT_EQ(part.size(), 2u);
+	EXPECT_EQ(part.results[0], all.results[1]);
+	EXPECT_EQ(part.results[1], all.results[2]);
+	EXPECT_EQ((aut::test_func{ square_product, {.first_case = all.size() - 1, .print = false} }.report.size()), 1u);
+	EXPECT_EQ((aut::test_func{ square_product, {.first_case = all.size() + 5, .print = false} }.report.size()), 0u);
+
+	// t-wise runs are split by the rows of the covering array.
+	const auto pairwise = aut::test_func{ myFunc2, {.coverage = aut::coverage::pairwise, .print = false} }.report;
+	const auto rows = aut::test_func{ myFunc2, {.coverage = aut::coverage::pairwise, .first_case = 2, .print = false} }.report;
+	ASSERT_EQ(rows.size(), pairwise.size() - 2);
+	EXPECT_EQ(rows.results.front(), pairwise.results[2]);
+}
+
+// Blocks of 3 cases as tests GeneratedCases.cases_<first>_<last>, and every case of a functor as a test of its own.
+auto square_functor = [](aut::in_range<-10, 10> a, aut::one_of<1, 2> b) -> aut::greater_eq<0> { return a * a * b; };
+const size_t registered_blocks = aut::register_test_func("GeneratedCases", square_product, 3);
+const size_t registered_cases = aut::register_test_func("GeneratedSingleCases", square_functor, 1, {.first_case = 1});
+
+TEST(TestGenerator, RegisteredCases) {
+	constexpr size_t num_cases = aut::case_space<aut::in_range<-10, 10>, aut::one_of<1, 2>>::size;
+	EXPECT_EQ(registered_blocks, (num_cases + 2) / 3);
+	EXPECT_EQ(registered_cases, num_cases - 1);
+
+	const auto* unit_test = testing::UnitTest::GetInstance();
+	const testing::TestSuite* blocks = nullptr;
+	for (int i = 0; i < unit_test->total_test_suite_count(); i++) {
+		if (std::string{ unit_test->GetTestSuite(i)->name() } == "GeneratedCases") blocks = unit_test->GetTestSuite(i);
+	}
+	ASSERT_NE(blocks, nullptr);
+	ASSERT_EQ(static_cast<size_t>(blocks->total_test_count()), registered_blocks);
+	EXPECT_STREQ(blocks->GetTestInfo(0)->name(), "cases_0_2");
+	EXPECT_STREQ(blocks->GetTestInfo(1)->name(), "cases_3_3");
+}
+
+// Only misses a - b = -255 and 255.
+aut::in_range<-254, 254> narrow_difference(aut::in_range<-128, 127> a, aut::in_range<-128, 127> b) {
+	return static_cast<int>(a) - static_cast<int>(b);
+}
+
+// Wrong for a single float between 1 and 2.
+aut::in_range<1.f, 4.f> square_one_two(aut::in_range<1.f, 2.f> x) {
+	return x.m_t == 1.5f ? -1.f : x.m_t * x.m_t;
+}
+
+TEST(TestGenerator, ExhaustiveDomain) {
+	static_assert(aut::domain_space<aut::in_range<-128, 127>, aut::one_of<1, 2, 5>>::size == 256 * 3);
+	static_assert(aut::domain_space<aut::in_range<-1.f, 1.f>>::size == 2 * 0x3f800000ull + 2);
+	static_assert(aut::domain_space<aut::_not<aut::in_range<-1.f, 1.f>>>::radices[0] == 2 * (0x7f800000ull - 0x3f800000ull) + 1);
+	static_assert(aut::domain_space<aut::greater_eq<0ll, long long>, aut::greater_eq<0ll, long long>>::size == UINT64_MAX);
+	static_assert(std::get<1>(aut::domain_space<aut::in_range<0, 9>, aut::one_of<1, 2, 5>>::at(5)) == 5);
+	static_assert(std::get<0>(aut::domain_space<aut::in_range<1.f, 2.f>>::at(1)) == 1.f + 0x1.0p-23f);
+
+	const auto ints = aut::exhaust_func{ narrow_difference, {.threads = 2, .batch_size = 1000, .print = false} }.report;
+	EXPECT_EQ(ints.size(), 65536u);
+	EXPECT_EQ(ints.num_failed, 2u);
+	EXPECT_EQ(ints.num_passed, 65534u);
+	ASSERT_EQ(ints.failures.size(), 2u);
+	EXPECT_EQ(ints.failures[0].case_index, 255u);
+	EXPECT_EQ(ints.failures[0].arguments, std::make_tuple(-128, 127));
+	EXPECT_EQ(ints.failures[0].output, -255);
+	EXPECT_EQ(ints.failures[1].case_index, 255u * 256u);
+	EXPECT_EQ(ints.arguments(ints.failures[1].case_index), std::make_tuple(127, -128));
+	EXPECT_EQ((aut::exhaust_func{ narrow_difference, {.max_failures = 1, .print = false} }.report.failures.size()), 1u);
+
+	// Every float in [1, 2] in steps of one ULP.
+	const auto floats = aut::exhaust_func{ square_one_two, {.print = false} }.report;
+	EXPECT_EQ(floats.size(), (1u << 23) + 1);
+	EXPECT_EQ(floats.num_failed, 1u);
+	ASSERT_EQ(floats.failures.size(), 1u);
+	EXPECT_EQ(floats.failures[0].case_index, 1u << 22);
+	EXPECT_EQ(std::get<0>(floats.failures[0].arguments), 1.5f);
+
+	std::ostringstream os;
+	os << floats;
+	EXPECT_NE(os.str().find("FAILED, case = 4194304, input = (1.5), output = -1"), std::string::npos) << os.str();
+	EXPECT_NE(os.str().find("8388609 exhaustive tests, 8388608 passed, 1 failed"), std::string::npos) << os.str();
+
+	EXPECT_THROW((aut::exhaust_func{ square_one_two, {.max_cases = 1000, .print = false} }), std::length_error);
+}
+
+// Instrumented in coverage_targets.cpp.
+aut::greater_eq<0> magic_bytes(aut::in_range<0, 0xffffff> a, aut::in_range<0, 100> b);
+
+TEST(TestGenerator, ConstrainedMutations) {
+	using arg_types = std::tuple<aut::_or<aut::in_range<-5, 5>, aut::one_of<100, 200>>, aut::in_range<1.f, 2.f>, aut::in_range<0, 0xffffff>>;
+	using space = aut::case_space_of<arg_types>;
+	using mutator = aut::detail::case_mutator_of<arg_types>::type;
+	auto args = space::at(0);
+	const auto other = space::at(space::size - 1);
+	aut::detail::splitmix64 rng{ 1 };
+	for (int i = 0; i < 10000; i++) {
+		mutator::mutate(args, other, rng);
+		const int a = std::get<0>(args);
+		EXPECT_TRUE((a >= -5 && a <= 5) || a == 100 || a == 200) << a;
+		EXPECT_TRUE(std::get<1>(args) >= 1.f && std::get<1>(args) <= 2.f) << std::get<1>(args);
+		EXPECT_TRUE(std::get<2>(args) >= 0 && std::get<2>(args) <= 0xffffff) << std::get<2>(args);
+	}
+
+	// Without instrumentation, the mutations are not guided.
+	const auto unguided = aut::guided_fuzz_func{ square_product, {.cases = 1000, .print = false} }.report;
+	EXPECT_EQ(unguided.size(), 1000u);
+	EXPECT_TRUE(unguided.passed());
+	EXPECT_EQ(unguided.num_passed, 1000u);
+	EXPECT_EQ(unguided.edges, 0u);
+	EXPECT_EQ(unguided.corpus_size, (aut::case_space<aut::in_range<-10, 10>, aut::one_of<1, 2>>::size));
+
+	// The corpus always starts with a seed.
+	const auto unseeded = aut::guided_fuzz_func{ square_product, {.cases = 10, .max_seeds = 0, .print = false} }.report;
+	EXPECT_EQ(unseeded.num_passed, 10u);
+	EXPECT_EQ(unseeded.corpus_size, 1u);
+	const auto empty = aut::guided_fuzz_func{ square_product, {.cases = 0, .print = false} }.report;
+	EXPECT_EQ(empty.size(), 0u);
+	EXPECT_EQ(empty.corpus_size, 0u);
+}
+
+TEST(TestGenerator, CoverageGuided) {
+#ifndef AUT_TEST_TRACE_PC
+	GTEST_SKIP() << "The compiler does not support -fsanitize-coverage=trace-pc.";
+#endif
+	const auto guided = aut::guided_fuzz_func{ magic_bytes, {.cases = 50'000, .print = false} }.report;
+	EXPECT_GT(guided.edges, 0u);
+	EXPECT_GT(guided.corpus_size, 0u);
+	ASSERT_FALSE(guided.failures.empty()) << guided;
+	EXPECT_EQ(std::get<0>(guided.failures[0].arguments), 0x5c172a);
+	EXPECT_EQ(std::get<0>(guided.failures[0].shrunk_arguments), 0x5c172a);
+
+	std::ostringstream os;
+	os << guided;
+	EXPECT_NE(os.str().find("50000 guided tests"), std::string::npos) << os.str();
+
+	// Blind sampling over the same domains misses the bug.
+	EXPECT_TRUE((aut::fuzz_func{ magic_bytes, {.cases = 50'000, .print = false} }.report.passed()));
+}
+
+// Fails if an object is reused without reset.
+class HistoryFixture {
+public:
+	static inline std::atomic<int> constructions = 0;
+
+	HistoryFixture() : history(4096) { constructions++; }
+
+	aut::greater_eq<0> push(aut::in_range<0, 10> a) {
+		history[size++] = a;
+		return size == 1 ? static_cast<int>(a) : -1;
+	}
+
+	void reset() { size = 0; }
+
+	std::vector<int> history;
+	size_t size = 0;
+};
+
+// Reset by copy assignment from a prototype.
+struct CounterFixture {
+	aut::greater_eq<0> count(aut::in_range<0, 10> a) {
+		calls++;
+		return calls == 1 ? static_cast<int>(a) : -1;
+	}
+
+	int calls = 0;
+};
+
+// Never reset, as the member function is const. Not copyable.
+struct ConstFixture {
+	aut::greater_eq<0> scale(aut::in_range<0, 10> a) const { return a * *factor; }
+
+	std::unique_ptr<int> factor = std::make_unique<int>(2);
+};
+
+TEST(TestGenerator, MemberFunction) {
+	HistoryFixture::constructions = 0;
+	const auto factory = [] { return HistoryFixture{}; };
+
+	EXPECT_TRUE((aut::test_func{ &HistoryFixture::push, factory, {.print = false} }.report.passed()));
+	EXPECT_EQ(HistoryFixture::constructions, 1);
+
+	const auto parallel = aut::test_func{ &HistoryFixture::push, factory, {.threads = 4, .print = false} }.report;
+	EXPECT_TRUE(parallel.passed());
+	EXPECT_LE(HistoryFixture::constructions, 1 + 4);
+
+	// A reset callable replaces reset(). This one keeps the state, so all but the first case fail.
+	const auto stale = aut::test_func{ &HistoryFixture::push, aut::fixture{ factory, [](HistoryFixture&) {} }, {.print = false} }.report;
+	EXPECT_EQ(stale.num_passed, 1);
+	EXPECT_EQ(stale.num_failed, stale.size() - 1);
+
+	EXPECT_TRUE((aut::test_func{ &CounterFixture::count, [] { return CounterFixture{}; }, {.print = false} }.report.passed()));
+	EXPECT_TRUE((aut::test_func{ &ConstFixture::scale, [] { return ConstFixture{}; }, {.print = false} }.report.passed()));
+	// Objects of const member functions are not reset, even with a reset callable.
+	size_t resets = 0;
+	const auto counted = aut::fixture{ [] { return ConstFixture{}; }, [&resets](ConstFixture&) { resets++; } };
+	EXPECT_TRUE((aut::test_func{ &ConstFixture::scale, counted, {.print = false} }.report.passed()));
+	EXPECT_EQ(resets, 0u);
+
+	HistoryFixture::constructions = 0;
+	const auto fuzzed = aut::fuzz_func{ &HistoryFixture::push, factory, {.cases = 10000, .print = false} }.report;
+	EXPECT_EQ(fuzzed.num_passed, 10000);
+	EXPECT_EQ(HistoryFixture::constructions, 1);
+}
+
+TEST(Benchmark, Statistics) {
+	const auto r = aut::summarize("stats", { 5., 1., 4., 2., 3. }, 10);
+
+	EXPECT_DOUBLE_EQ(r.mean, 3.);
+	EXPECT_DOUBLE_EQ(r.min, 1.);
+	EXPECT_DOUBLE_EQ(r.max, 5.);
+	EXPECT_DOUBLE_EQ(r.p50, 3.);
+	EXPECT_DOUBLE_EQ(r.p90, 4.6);
+	EXPECT_NEAR(r.stddev, 1.5811, 1e-4);
+	EXPECT_NEAR(r.ci95_low, 3. - 2.776 * 1.5811 / std::sqrt(5.), 1e-3);
+	EXPECT_EQ(r.iterations_per_sample, 10);
+}
+
+TEST(Benchmark, Run) {
+	aut::benchmark_options options;
+	options.samples = 20;
+	options.warmup_samples = 2;
+	options.min_sample_time = std::chrono::microseconds{ 10 };
+
+	const auto r = aut::run_benchmark("myFunc2", [] { return myFunc2(1.f, 2.f, 3); }, options);
+	EXPECT_EQ(r.samples, 20);
+	EXPECT_GE(r.iterations_per_sample, 1);
+	EXPECT_LE(r.min, r.p50);
+	EXPECT_LE(r.p50, r.p90);
+	EXPECT_LE(r.p90, r.p99);
+	EXPECT_LE(r.p99, r.max);
+	EXPECT_LE(r.ci95_low, r.mean);
+	EXPECT_GE(r.ci95_high, r.mean);
+
+	std::ostringstream json;
+	aut::write_json(json, std::vector{ r });
+	EXPECT_EQ(json.str().rfind("{\"benchmarks\": [\n  {\"name\": \"myFunc2\", \"samples\": 20", 0), 0) << json.str();
+}
+
 //TEST(TestGenerator, Runtime) {
 //	aut::measure_runtime([]() {return myFunc2(1, 2, 3); });
 //	aut::measure_runtime([]() {return myFunc2_unconstrained(1, 2, 3); });